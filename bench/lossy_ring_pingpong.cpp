@@ -0,0 +1,123 @@
+/**
+ * LossyRingBuffer ping-pong microbenchmark
+ *
+ * Two threads bounce one item through a pair of rings (A -> B on one ring, B -> A on the other),
+ * so every round trip pays two pushes, two pops and the cross-thread handoff of both indices.
+ * A streaming pass then reports one-way throughput with the consumer running flat out.
+ *
+ * Waiting sides yield, so results stay meaningful on machines with fewer cores than threads.
+ */
+#include "LossyRingBuffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using margelo::nitro::cxpmobile_tpsdk::core::LossyRingBuffer;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Same order of size as the small stream items (TradeData, MiniTickerData)
+    struct Item
+    {
+        uint64_t sequence;
+        uint64_t payload[5];
+    };
+
+    using Ring = LossyRingBuffer<Item, 1024>;
+
+    template <typename Ring>
+    void popWait(Ring &ring, Item &item)
+    {
+        while (!ring.pop(item))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    void pingPong(uint64_t roundTrips)
+    {
+        static Ring ping;
+        static Ring pong;
+
+        std::thread echo([&]()
+                         {
+            Item item{};
+            for (uint64_t i = 0; i < roundTrips; ++i)
+            {
+                popWait(ping, item);
+                pong.push(item);
+            } });
+
+        std::vector<double> samples;
+        samples.reserve(roundTrips);
+        Item item{};
+        const auto start = Clock::now();
+        for (uint64_t i = 0; i < roundTrips; ++i)
+        {
+            const auto sent = Clock::now();
+            item.sequence = i;
+            ping.push(item);
+            popWait(pong, item);
+            samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - sent).count());
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        echo.join();
+
+        std::sort(samples.begin(), samples.end());
+        std::printf("ping-pong   %llu round trips: %.2f M round trips/s, p50 %.0f ns, p99 %.0f ns\n",
+                    static_cast<unsigned long long>(roundTrips), roundTrips / seconds / 1e6,
+                    samples[samples.size() / 2], samples[samples.size() * 99 / 100]);
+    }
+
+    void streaming(uint64_t total)
+    {
+        static Ring ring;
+        ring.resetStats();
+
+        std::atomic<bool> producerDone{false};
+        const auto start = Clock::now();
+        std::thread producer([&]()
+                             {
+            Item item{};
+            for (uint64_t i = 0; i < total; ++i)
+            {
+                item.sequence = i;
+                ring.push(item);
+            }
+            producerDone.store(true, std::memory_order_release); });
+
+        Item item{};
+        for (;;)
+        {
+            const bool done = producerDone.load(std::memory_order_acquire);
+            if (!ring.pop(item) && done)
+            {
+                break;
+            }
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        producer.join();
+
+        std::printf("streaming   %llu pushes: %.1f M pushes/s, popped %llu, lost %llu\n",
+                    static_cast<unsigned long long>(total), total / seconds / 1e6,
+                    static_cast<unsigned long long>(ring.getPopCount()),
+                    static_cast<unsigned long long>(ring.getLostCount()));
+    }
+}
+
+int main()
+{
+    for (int run = 0; run < 3; ++run)
+    {
+        pingPong(200'000);
+        streaming(20'000'000);
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * LossyRingBuffer stress test: one producer overwriting a small ring, one consumer reading it
+ *
+ * Checks:
+ * - No torn item: every word of a popped item carries the same sequence number
+ * - No reordering: popped sequence numbers strictly increase
+ * - Accounting: popped + lost == pushed once the producer is done and the ring is drained
+ *
+ * Exit code is non-zero on any failure.
+ */
+#include "LossyRingBuffer.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <thread>
+#include <vector>
+
+using margelo::nitro::cxpmobile_tpsdk::core::LossyRingBuffer;
+
+namespace
+{
+    // Large enough that a concurrent overwrite is likely to land mid-copy
+    struct Item
+    {
+        uint64_t first;
+        uint64_t payload[62];
+        uint64_t last;
+    };
+
+    bool consistent(const Item &item)
+    {
+        if (item.first != item.last)
+        {
+            return false;
+        }
+        for (uint64_t word : item.payload)
+        {
+            if (word != item.first)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void fill(Item &item, uint64_t sequence)
+    {
+        item.first = sequence;
+        for (uint64_t &word : item.payload)
+        {
+            word = sequence;
+        }
+        item.last = sequence;
+    }
+
+    enum class Mode
+    {
+        PUSH,      // push(item)
+        CLAIM,     // claim() + commit()
+        BULK       // push_bulk / pop_bulk
+    };
+
+    template <size_t Size>
+    bool run(const char *name, Mode mode, uint64_t total)
+    {
+        static LossyRingBuffer<Item, Size> ring;
+        ring.resetStats();
+
+        std::atomic<bool> producerDone{false};
+        std::thread producer([&]()
+                             {
+            std::vector<Item> batch(8);
+            for (uint64_t sequence = 1; sequence <= total;)
+            {
+                if (mode == Mode::CLAIM)
+                {
+                    fill(*ring.claim(), sequence++);
+                    ring.commit();
+                }
+                else if (mode == Mode::BULK)
+                {
+                    size_t count = 0;
+                    while (count < batch.size() && sequence <= total)
+                    {
+                        fill(batch[count++], sequence++);
+                    }
+                    ring.push_bulk(std::span<const Item>(batch.data(), count));
+                }
+                else
+                {
+                    Item item;
+                    fill(item, sequence++);
+                    ring.push(item);
+                }
+            }
+            producerDone.store(true, std::memory_order_release); });
+
+        uint64_t popped = 0;
+        uint64_t torn = 0;
+        uint64_t reordered = 0;
+        uint64_t lastSequence = 0;
+        std::vector<Item> out(8);
+        auto check = [&](const Item &item)
+        {
+            if (!consistent(item))
+            {
+                ++torn;
+            }
+            else if (item.first <= lastSequence)
+            {
+                ++reordered;
+            }
+            lastSequence = item.first;
+            ++popped;
+        };
+
+        for (;;)
+        {
+            const bool done = producerDone.load(std::memory_order_acquire);
+            size_t count = 0;
+            if (mode == Mode::BULK)
+            {
+                count = ring.pop_bulk(std::span<Item>(out));
+                for (size_t i = 0; i < count; ++i)
+                {
+                    check(out[i]);
+                }
+            }
+            else if (ring.pop(out[0]))
+            {
+                check(out[0]);
+                count = 1;
+            }
+            // Producer finished before this empty read: nothing left to drain
+            if (done && count == 0)
+            {
+                break;
+            }
+        }
+        producer.join();
+
+        const uint64_t lost = ring.getLostCount();
+        const bool accounted = popped + lost == total && ring.getPushCount() == total;
+        const bool ok = torn == 0 && reordered == 0 && accounted;
+        std::printf("%-28s pushed=%llu popped=%llu lost=%llu torn=%llu reordered=%llu %s\n", name,
+                    static_cast<unsigned long long>(total), static_cast<unsigned long long>(popped),
+                    static_cast<unsigned long long>(lost), static_cast<unsigned long long>(torn),
+                    static_cast<unsigned long long>(reordered), ok ? "OK" : "FAILED");
+        return ok;
+    }
+}
+
+int main()
+{
+    constexpr uint64_t TOTAL = 5'000'000;
+
+    bool ok = true;
+    ok &= run<4>("push, 4 slots", Mode::PUSH, TOTAL);
+    ok &= run<64>("push, 64 slots", Mode::PUSH, TOTAL);
+    ok &= run<4>("claim/commit, 4 slots", Mode::CLAIM, TOTAL);
+    ok &= run<64>("claim/commit, 64 slots", Mode::CLAIM, TOTAL);
+    ok &= run<16>("push_bulk/pop_bulk, 16 slots", Mode::BULK, TOTAL);
+    return ok ? 0 : 1;
+}
@@ -24,19 +24,24 @@
 
 namespace margelo::nitro::cxpmobile_tpsdk
 {
-    // Object pools removed - no longer used (optimized processors use core::ObjectPool)
+    // Object pools removed - no longer used (optimized processors parse into their ring's staging item)
 
     // Pre-allocated buffers (thread-local, initialized on first use)
     thread_local TpSdkCppHybrid::PreAllocatedBuffers TpSdkCppHybrid::threadLocalBuffers_;
 
-    // Callback queue
-    std::queue<TpSdkCppHybrid::CallbackTask> TpSdkCppHybrid::callbackQueue_;
-    std::mutex TpSdkCppHybrid::callbackQueueMutex_;
+    // Callback lanes (one per stream, drained in priority order)
+    core::CallbackLanes TpSdkCppHybrid::callbackLanes_;
+    TpSdkCppHybrid::OrderBookDiffState TpSdkCppHybrid::orderBookDiffState_;
 
     TpSdkCppHybrid *TpSdkCppHybrid::singletonInstance_ = nullptr;
     std::mutex TpSdkCppHybrid::singletonMutex_;
     // useOptimizedProcessors_ removed - always use optimized processors
 
+    TpSdkCppHybrid::~TpSdkCppHybrid()
+    {
+        shutdownOptimizedProcessors();
+    }
+
     std::variant<nitro::NullType, WebSocketMessageResultNitro> TpSdkCppHybrid::processWebSocketMessage(
         const std::string &messageJson)
     {
@@ -45,6 +50,20 @@ namespace margelo::nitro::cxpmobile_tpsdk
         {
             return nitro::NullType{};
         }
+
+        // Parse-in-worker mode: one memcpy on the JS thread, detection/parsing on the ingest worker
+        if (instance->frameIngestor_)
+        {
+            if (!instance->frameIngestor_->push(messageJson))
+            {
+                // Ring full or frame too large. Not parsed inline: the ingest worker is the
+                // processors' only producer. Counted (getDroppedFrameCount) and the books resync
+                // once the worker catches up, since the frame may have been a depth delta
+                instance->frameDropPending_.store(true, std::memory_order_release);
+            }
+            return nitro::NullType{};
+        }
+
         TpSdkCppHybrid::routeMessageToQueue(messageJson, instance);
         return nitro::NullType{};
     }
@@ -61,6 +80,54 @@ namespace margelo::nitro::cxpmobile_tpsdk
         OrderBookManager::orderbookUnsubscribe(instance);
     }
 
+    void TpSdkCppHybrid::orderbookResyncSubscribe(const std::function<void(const std::string &)> &callback)
+    {
+        TpSdkCppHybrid *instance = getOrCreateSingletonInstance();
+        OrderBookManager::orderbookResyncSubscribe(instance, callback);
+    }
+
+    void TpSdkCppHybrid::orderbookResyncUnsubscribe()
+    {
+        TpSdkCppHybrid *instance = getSingletonInstance();
+        OrderBookManager::orderbookResyncUnsubscribe(instance);
+    }
+
+    void TpSdkCppHybrid::loadOrderBookSnapshot(const std::string &symbol, const std::string &snapshotJson)
+    {
+        TpSdkCppHybrid *instance = getOrCreateSingletonInstance();
+        OrderBookManager::loadOrderBookSnapshot(instance, symbol, snapshotJson);
+    }
+
+    void TpSdkCppHybrid::orderbookDiffSubscribe(const std::function<void(const OrderBookDiffMessageData &)> &callback)
+    {
+        TpSdkCppHybrid *instance = getOrCreateSingletonInstance();
+        OrderBookManager::orderbookDiffSubscribe(instance, callback);
+    }
+
+    void TpSdkCppHybrid::orderbookDiffUnsubscribe()
+    {
+        TpSdkCppHybrid *instance = getSingletonInstance();
+        OrderBookManager::orderbookDiffUnsubscribe(instance);
+    }
+
+    void TpSdkCppHybrid::requestOrderBookKeyframe(const std::string &symbol)
+    {
+        TpSdkCppHybrid *instance = getOrCreateSingletonInstance();
+        OrderBookManager::requestOrderBookKeyframe(instance, symbol);
+    }
+
+    void TpSdkCppHybrid::setOrderBookAggregation(const std::string &symbol, const std::string &aggregation)
+    {
+        TpSdkCppHybrid *instance = getOrCreateSingletonInstance();
+        OrderBookManager::setOrderBookAggregation(instance, symbol, aggregation);
+    }
+
+    void TpSdkCppHybrid::setOrderBookAggregationLevels(const std::string &symbol, const std::vector<std::string> &aggregations)
+    {
+        TpSdkCppHybrid *instance = getOrCreateSingletonInstance();
+        OrderBookManager::setOrderBookAggregationLevels(instance, symbol, aggregations);
+    }
+
     void TpSdkCppHybrid::miniTickerSubscribe(const std::function<void(const TickerMessageData &)> &callback)
     {
         TpSdkCppHybrid *instance = getOrCreateSingletonInstance();
@@ -85,6 +152,90 @@ namespace margelo::nitro::cxpmobile_tpsdk
         TickerManager::miniTickerPairUnsubscribe(instance);
     }
 
+    void TpSdkCppHybrid::enablePushDelivery(const std::function<void()> &onPending)
+    {
+        TpSdkCppHybrid *instance = getOrCreateSingletonInstance();
+        {
+            std::lock_guard<std::mutex> lock(instance->pushDeliveryMutex_);
+            instance->pushDeliveryCallback_ = onPending;
+        }
+        instance->pushDeliveryScheduled_.store(false, std::memory_order_release);
+        instance->pushDeliveryEnabled_.store(true, std::memory_order_release);
+
+        // Deliver anything queued before push mode was enabled
+        if (callbackLanes_.size() > 0)
+        {
+            schedulePushDelivery(instance);
+        }
+    }
+
+    void TpSdkCppHybrid::disablePushDelivery()
+    {
+        TpSdkCppHybrid *instance = getSingletonInstance();
+        if (instance == nullptr)
+        {
+            return;
+        }
+
+        instance->pushDeliveryEnabled_.store(false, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(instance->pushDeliveryMutex_);
+        instance->pushDeliveryCallback_ = nullptr;
+    }
+
+    void TpSdkCppHybrid::setSymbolPrecision(const std::string &symbol, double priceDecimals, double quantityDecimals)
+    {
+        // Negative (or NaN) means shortest round-trip, otherwise clamp to what the formatter supports
+        auto toDecimals = [](double decimals)
+        {
+            if (!(decimals >= 0.0))
+            {
+                return core::NumberFormatter::SHORTEST;
+            }
+            return static_cast<int>(std::min(decimals, static_cast<double>(core::NumberFormatter::MAX_DECIMALS)));
+        };
+
+        core::SymbolPrecision precision;
+        precision.priceDecimals = toDecimals(priceDecimals);
+        precision.quantityDecimals = toDecimals(quantityDecimals);
+        core::SymbolPrecisionRegistry::instance().set(symbol, precision);
+    }
+
+    void TpSdkCppHybrid::schedulePushDelivery(TpSdkCppHybrid *instance)
+    {
+        if (instance == nullptr || !instance->pushDeliveryEnabled_.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        // Coalesce: one notification in flight until JS starts draining
+        if (instance->pushDeliveryScheduled_.exchange(true, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        std::function<void()> onPending;
+        {
+            std::lock_guard<std::mutex> lock(instance->pushDeliveryMutex_);
+            onPending = instance->pushDeliveryCallback_;
+        }
+        if (!onPending)
+        {
+            instance->pushDeliveryScheduled_.store(false, std::memory_order_release);
+            return;
+        }
+
+        try
+        {
+            // Nitro dispatches the JS function onto the JS thread (CallInvoker), never runs it inline
+            onPending();
+        }
+        catch (const std::exception &e)
+        {
+            instance->pushDeliveryScheduled_.store(false, std::memory_order_release);
+            std::cerr << "[C++ ERROR] Push delivery notification exception: " << e.what() << std::endl;
+        }
+    }
+
     void TpSdkCppHybrid::klineSubscribe(const std::function<void(const KlineMessageData &)> &callback)
     {
         TpSdkCppHybrid *instance = getOrCreateSingletonInstance();
@@ -127,54 +278,200 @@ namespace margelo::nitro::cxpmobile_tpsdk
     {
         try
         {
-            // Create processors with appropriate pool sizes
-            depthProcessor_ = std::make_unique<core::DepthProcessor>(100, 200);
-            tradeProcessor_ = std::make_unique<core::TradeProcessor>(50, 100);
-            tickerProcessor_ = std::make_unique<core::TickerProcessor>(100, 200);
-            miniTickerProcessor_ = std::make_unique<core::MiniTickerProcessor>(100, 200);
-            klineProcessor_ = std::make_unique<core::KlineProcessor>(50, 100);
-            userDataProcessor_ = std::make_unique<core::UserDataProcessor>(20, 40);
+            // Create processors (ring buffer sizes are fixed per stream type)
+            depthProcessor_ = std::make_unique<core::DepthProcessor>();
+            tradeProcessor_ = std::make_unique<core::TradeProcessor>();
+            tickerProcessor_ = std::make_unique<core::TickerProcessor>();
+            miniTickerProcessor_ = std::make_unique<core::MiniTickerProcessor>();
+            klineProcessor_ = std::make_unique<core::KlineProcessor>();
+            userDataProcessor_ = std::make_unique<core::UserDataProcessor>();
 
             // Start processors with callbacks that convert to Nitro types
-            depthProcessor_->start([this](const core::DepthData &data)
-                                   { this->onOptimizedDepthUpdate(data); });
+            // Depth and trades are dispatched per batch (one queued callback per batch)
+            auto onDepth = [this](std::span<const core::DepthData> batch)
+            { this->onOptimizedDepthBatch(batch); };
+            auto onTrade = [this](std::span<const core::TradeData> batch)
+            { this->onOptimizedTradeBatch(batch); };
+            auto onTicker = [this](const core::TickerData &data)
+            { this->onOptimizedTickerUpdate(data); };
+            auto onMiniTicker = [this](const core::MiniTickerData &data)
+            { this->onOptimizedMiniTickerUpdate(data); };
+            auto onKline = [this](const core::KlineData &data)
+            { this->onOptimizedKlineUpdate(data); };
+            auto onUserData = [this](const core::UserData &data)
+            { this->onOptimizedUserDataUpdate(data); };
+
+            if (DEFAULT_SHARED_STREAM_EXECUTOR)
+            {
+                // One pool (2-4 workers by core count) drains all six rings
+                streamPool_ = std::make_unique<ThreadPool>();
+                depthProcessor_->start(onDepth, *streamPool_);
+                tradeProcessor_->start(onTrade, *streamPool_);
+                tickerProcessor_->start(onTicker, *streamPool_);
+                miniTickerProcessor_->start(onMiniTicker, *streamPool_);
+                klineProcessor_->start(onKline, *streamPool_);
+                userDataProcessor_->start(onUserData, *streamPool_);
+            }
+            else
+            {
+                depthProcessor_->start(onDepth);
+                tradeProcessor_->start(onTrade);
+                tickerProcessor_->start(onTicker);
+                miniTickerProcessor_->start(onMiniTicker);
+                klineProcessor_->start(onKline);
+                userDataProcessor_->start(onUserData);
+            }
 
-            tradeProcessor_->start([this](const core::TradeData &data)
-                                   { this->onOptimizedTradeUpdate(data); });
+            // Start ingest worker last: it feeds the processors above
+            if (DEFAULT_PARSE_IN_WORKER)
+            {
+                ingestFrameBuffer_.reserve(4096);
+                frameIngestor_ = std::make_unique<core::RawFrameIngestor>();
+                frameIngestor_->start([this](std::string_view frame)
+                                      { this->onRawFrame(frame); });
+            }
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "[TpSdkCppHybrid] Failed to initialize optimized processors: " << e.what() << std::endl;
+            // Processors are required - rethrow or handle error appropriately
+        }
+    }
 
-            tickerProcessor_->start([this](const core::TickerData &data)
-                                    { this->onOptimizedTickerUpdate(data); });
+    void TpSdkCppHybrid::shutdownOptimizedProcessors()
+    {
+        // Stop producer side first so no frame is routed into a stopped processor
+        if (frameIngestor_)
+        {
+            frameIngestor_->stop();
+        }
 
-            miniTickerProcessor_->start([this](const core::MiniTickerData &data)
-                                        { this->onOptimizedMiniTickerUpdate(data); });
+        if (depthProcessor_)
+            depthProcessor_->stop();
+        if (tradeProcessor_)
+            tradeProcessor_->stop();
+        if (tickerProcessor_)
+            tickerProcessor_->stop();
+        if (miniTickerProcessor_)
+            miniTickerProcessor_->stop();
+        if (klineProcessor_)
+            klineProcessor_->stop();
+        if (userDataProcessor_)
+            userDataProcessor_->stop();
+    }
 
-            klineProcessor_->start([this](const core::KlineData &data)
-                                   { this->onOptimizedKlineUpdate(data); });
+    void TpSdkCppHybrid::onRawFrame(std::string_view frame)
+    {
+        // Frames were dropped before this one: every book may have missed a delta
+        if (frameDropPending_.exchange(false, std::memory_order_acq_rel))
+        {
+            OrderBookManager::resyncAllOrderBooks(this);
+        }
 
-            userDataProcessor_->start([this](const core::UserData &data)
-                                      { this->onOptimizedUserDataUpdate(data); });
+        // Reused buffer: no allocation once capacity covers the largest frame
+        ingestFrameBuffer_.assign(frame.data(), frame.size());
+        routeMessageToQueue(ingestFrameBuffer_, this);
+    }
+
+    void TpSdkCppHybrid::onOptimizedDepthBatch(std::span<const core::DepthData> batch)
+    {
+        // Every message goes through its symbol's sequence-checked book; the order book lane keeps
+        // only the latest book per symbol, so each changed symbol is converted once per batch
+        std::vector<OrderBookMessageData> orderBookBatch;
+        std::vector<std::string> resyncSymbols;
+        bool canResync;
+        {
+            std::lock_guard<std::mutex> callbackLock(orderBookResyncCallbackMutex_);
+            canResync = static_cast<bool>(orderBookResyncCallback_);
         }
-        catch (const std::exception &e)
         {
-            std::cerr << "[TpSdkCppHybrid] Failed to initialize optimized processors: " << e.what() << std::endl;
-            // Processors are required - rethrow or handle error appropriately
+            std::lock_guard<std::mutex> lock(orderBookState_.mutex);
+            std::vector<size_t> changed; // Batch index of the last applied message per symbol
+            for (size_t i = 0; i < batch.size(); ++i)
+            {
+                const std::string_view symbol(batch[i].symbol, batch[i].symbolLen);
+                const core::OrderBookSync::Result result = orderBookState_.book(symbol).onDepth(batch[i], canResync);
+                if (result == core::OrderBookSync::Result::RESYNC_NEEDED)
+                {
+                    resyncSymbols.emplace_back(symbol);
+                }
+                else if (result == core::OrderBookSync::Result::APPLIED)
+                {
+                    auto it = std::find_if(changed.begin(), changed.end(), [&](size_t j)
+                                           { return symbol == std::string_view(batch[j].symbol, batch[j].symbolLen); });
+                    if (it == changed.end())
+                    {
+                        changed.push_back(i);
+                    }
+                    else
+                    {
+                        *it = i;
+                    }
+                }
+            }
+
+            const size_t maxRows = static_cast<size_t>(orderBookState_.maxRows);
+            for (size_t i : changed)
+            {
+                const core::OrderBookSync &sync = orderBookState_.book(std::string_view(batch[i].symbol, batch[i].symbolLen));
+                // A later gap in the same batch leaves the book unsynced; without a resync handler
+                // the book is built from the deltas alone and sent flagged as unsynced
+                if (sync.isSynced() || !canResync)
+                {
+                    const core::Decimal aggregation = orderBookState_.aggregationFor(std::string_view(batch[i].symbol, batch[i].symbolLen)).selected;
+                    orderBookBatch.push_back(core::DataConverter::convertOrderBook(batch[i], sync.book(), maxRows, aggregation));
+                    orderBookBatch.back().data.synced = sync.isSynced();
+                }
+            }
+        }
+
+        for (auto &symbol : resyncSymbols)
+        {
+            queueOrderBookResyncCallback(std::move(symbol), this);
+        }
+        if (!orderBookBatch.empty())
+        {
+            queueOrderBookCallback(std::move(orderBookBatch), this);
         }
     }
 
-    void TpSdkCppHybrid::onOptimizedDepthUpdate(const core::DepthData &data)
+    void TpSdkCppHybrid::onOptimizedTradeBatch(std::span<const core::TradeData> batch)
     {
-        // Convert to Nitro type and queue callback
-        auto orderBookData = core::DataConverter::convertDepth(data);
-        queueOrderBookCallback(std::move(orderBookData), this);
+        // Adaptive batching: trades accumulate per symbol and are flushed as one callback
+        // on size (larger while bursting) or timeout; the JS drain flushes timed-out batches
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(tradesState_.mutex);
+
+        tradesState_.noteArrivals(batch.size(), now);
+        for (const auto &data : batch)
+        {
+            tradesState_.addPending(core::DataConverter::convertTradeItem(data), now);
+            if (tradesState_.pendingCount >= tradesState_.batchLimit())
+            {
+                flushPendingTradesLocked(this, now);
+            }
+        }
+
+        if (tradesState_.shouldFlush(now))
+        {
+            flushPendingTradesLocked(this, now);
+        }
+        else if (tradesState_.pendingCount > 0 && tradesState_.firstPendingTime == now)
+        {
+            // Push mode: a new partial batch started, wake JS once so its drain can poll for the timeout
+            schedulePushDelivery(this);
+        }
     }
 
-    void TpSdkCppHybrid::onOptimizedTradeUpdate(const core::TradeData &data)
+    void TpSdkCppHybrid::flushPendingTradesLocked(TpSdkCppHybrid *instance, std::chrono::steady_clock::time_point now)
     {
-        // Convert to Nitro type and queue callback
-        auto tradeData = core::DataConverter::convertTrade(data);
-        std::vector<TradeMessageData> batch;
-        batch.push_back(std::move(tradeData));
-        queueTradeCallback(std::move(batch), this);
+        if (instance->tradesState_.pendingCount == 0)
+        {
+            return;
+        }
+
+        // Queued under the state lock so flushes from the stream worker and the JS drain keep their order
+        queueTradeCallback(instance->tradesState_.takePending(now), instance);
     }
 
     void TpSdkCppHybrid::onOptimizedTickerUpdate(const core::TickerData &data)
@@ -212,69 +509,92 @@ namespace margelo::nitro::cxpmobile_tpsdk
             return;
         }
 
-        // Always use optimized processors
-        auto type = core::SimdjsonParser::detectMessageType(messageJson);
+        // Streams keep one message type: probe once per stream, then route directly
+        core::StreamFormatCache &formats = core::StreamFormatCache::local();
+        const std::string_view stream = core::StreamFormatCache::streamName(messageJson);
+        core::MessageType type = core::MessageType::UNKNOWN;
+        const bool cached = formats.lookup(stream, type);
+        if (!cached)
+        {
+            type = core::SimdjsonParser::detectMessageType(messageJson);
+            formats.store(stream, type);
+        }
+
+        if (pushToProcessor(type, messageJson, instance) || !cached)
+        {
+            return;
+        }
+
+        // Cached type failed to parse: re-probe in case the stream's format changed
+        const core::MessageType probed = core::SimdjsonParser::detectMessageType(messageJson);
+        if (probed == type)
+        {
+            return;
+        }
+        if (probed == core::MessageType::UNKNOWN)
+        {
+            formats.invalidate(stream);
+            return;
+        }
+        formats.store(stream, probed);
+        pushToProcessor(probed, messageJson, instance);
+    }
 
+    bool TpSdkCppHybrid::pushToProcessor(core::MessageType type, const std::string &messageJson, TpSdkCppHybrid *instance)
+    {
+        // No processor (stream not subscribed) is not a parse failure
         switch (type)
         {
         case core::MessageType::DEPTH:
-            if (instance->depthProcessor_)
-            {
-                instance->depthProcessor_->push(messageJson);
-            }
-            break;
+            return !instance->depthProcessor_ || instance->depthProcessor_->push(messageJson);
         case core::MessageType::TRADE:
-            if (instance->tradeProcessor_)
-            {
-                instance->tradeProcessor_->push(messageJson);
-            }
-            break;
+            return !instance->tradeProcessor_ || instance->tradeProcessor_->push(messageJson);
         case core::MessageType::TICKER:
-            if (instance->tickerProcessor_)
-            {
-                instance->tickerProcessor_->push(messageJson);
-            }
-            break;
+            return !instance->tickerProcessor_ || instance->tickerProcessor_->push(messageJson);
         case core::MessageType::MINI_TICKER:
-            if (instance->miniTickerProcessor_)
-            {
-                instance->miniTickerProcessor_->push(messageJson);
-            }
-            break;
+            return !instance->miniTickerProcessor_ || instance->miniTickerProcessor_->push(messageJson);
         case core::MessageType::KLINE:
-            if (instance->klineProcessor_)
-            {
-                instance->klineProcessor_->push(messageJson);
-            }
-            break;
+            return !instance->klineProcessor_ || instance->klineProcessor_->push(messageJson);
         case core::MessageType::USER_DATA:
-            if (instance->userDataProcessor_)
-            {
-                instance->userDataProcessor_->push(messageJson);
-            }
-            break;
+            return !instance->userDataProcessor_ || instance->userDataProcessor_->push(messageJson);
+        case core::MessageType::MINI_TICKER_ARRAY:
+            return pushMiniTickerArray(messageJson, instance);
         default:
             // Unknown message types are ignored
-            break;
+            return true;
         }
     }
 
-    // Old message processing functions removed - using optimized processors only
-
-    void TpSdkCppHybrid::manageCallbackQueueSize(size_t dropRatio)
+    bool TpSdkCppHybrid::pushMiniTickerArray(const std::string &messageJson, TpSdkCppHybrid *instance)
     {
-        std::lock_guard<std::mutex> lock(callbackQueueMutex_);
-        if (callbackQueue_.size() >= MAX_CALLBACK_QUEUE_SIZE)
         {
-            size_t dropCount = MAX_CALLBACK_QUEUE_SIZE / dropRatio;
-            for (size_t i = 0; i < dropCount && !callbackQueue_.empty(); ++i)
+            std::lock_guard<std::mutex> callbackLock(instance->miniTickerPairCallbackMutex_);
+            if (!instance->miniTickerPairCallback_)
             {
-                callbackQueue_.pop();
+                return true; // Not subscribed: skip the parse
             }
         }
+
+        // One frame holds every symbol: parse here and deliver the whole list as one pair update
+        thread_local std::vector<core::MiniTickerData> tickers;
+        if (!core::SimdjsonParser::parseMiniTickerArray(messageJson, tickers))
+        {
+            return false;
+        }
+
+        std::vector<TickerMessageData> pairs;
+        pairs.reserve(tickers.size());
+        for (const auto &ticker : tickers)
+        {
+            pairs.push_back(core::DataConverter::convertMiniTicker(ticker));
+        }
+        queueMiniTickerPairCallback(std::move(pairs), instance);
+        return true;
     }
 
-    void TpSdkCppHybrid::queueOrderBookCallback(OrderBookMessageData &&orderBookData, TpSdkCppHybrid *instance)
+    // Old message processing functions removed - using optimized processors only
+
+    void TpSdkCppHybrid::queueOrderBookCallback(std::vector<OrderBookMessageData> &&batch, TpSdkCppHybrid *instance)
     {
         if (instance == nullptr)
         {
@@ -285,56 +605,92 @@ namespace margelo::nitro::cxpmobile_tpsdk
         std::function<void(const OrderBookMessageData &)> callback;
         {
             std::lock_guard<std::mutex> callbackLock(instance->orderBookCallbackMutex_);
-            if (!instance->orderBookCallback_)
-            {
-                std::cerr << "[TpSdkCppHybrid] queueOrderBookCallback: callback not registered" << std::endl;
-                return;
-            }
             callback = instance->orderBookCallback_;
         }
+        std::function<void(const OrderBookDiffMessageData &)> diffCallback;
+        {
+            std::lock_guard<std::mutex> callbackLock(instance->orderBookDiffCallbackMutex_);
+            diffCallback = instance->orderBookDiffCallback_;
+        }
+        if (!callback && !diffCallback)
+        {
+            std::cerr << "[TpSdkCppHybrid] queueOrderBookCallback: callback not registered" << std::endl;
+            return;
+        }
 
-        // Queue callback with OrderBookMessageData - RN store will handle all processing
+        // Latest book per symbol: a pending update for the same symbol is replaced in place.
+        // Diff patches are taken at delivery, against the view JS actually received
+        for (auto &orderBookData : batch)
         {
-            std::lock_guard<std::mutex> queueLock(callbackQueueMutex_);
+            std::string key = orderBookData.stream;
+            callbackLanes_.push(core::CallbackLane::ORDER_BOOK, [orderBookData = std::move(orderBookData), callback, diffCallback]()
+                                {
+                                    try
+                                    {
+                                        if (callback)
+                                        {
+                                            callback(orderBookData);
+                                        }
+                                        if (diffCallback)
+                                        {
+                                            deliverOrderBookDiff(orderBookData, diffCallback);
+                                        }
+                                    }
+                                    catch (const std::exception &e)
+                                    {
+                                        std::cerr << "[C++ ERROR] OrderBook callback exception: " << e.what() << std::endl;
+                                    } }, std::move(key));
+        }
 
-            // Estimate memory size (rough estimate: OrderBookMessageData can be large with bids/asks)
-            // Each OrderBookMessageData can contain 500+ bids/asks, estimate ~5KB per callback
-            size_t estimatedMemory = callbackQueue_.size() * 5120; // 5KB per callback estimate
+        schedulePushDelivery(instance);
+    }
 
-            // More aggressive dropping based on memory
-            if (estimatedMemory > MAX_CALLBACK_MEMORY_BYTES || callbackQueue_.size() >= MAX_CALLBACK_QUEUE_SIZE)
+    void TpSdkCppHybrid::deliverOrderBookDiff(const OrderBookMessageData &view, const std::function<void(const OrderBookDiffMessageData &)> &callback)
+    {
+        OrderBookDiffMessageData patchData;
+        {
+            std::lock_guard<std::mutex> lock(orderBookDiffState_.mutex);
+            core::OrderBookViewDiff::Patch patch;
+            if (!orderBookDiffState_.view(view.stream).next(view.data, patch))
             {
-                // Drop more aggressively if memory limit exceeded
-                size_t dropCount = callbackQueue_.size() / 2; // Drop 50% by default
-                if (estimatedMemory > MAX_CALLBACK_MEMORY_BYTES * 2)
-                {
-                    dropCount = callbackQueue_.size() * 3 / 4; // Drop 75% if way over limit
-                }
-                // Also drop if queue size exceeds limit even slightly
-                if (callbackQueue_.size() > MAX_CALLBACK_QUEUE_SIZE)
-                {
-                    dropCount = std::max(dropCount, callbackQueue_.size() - MAX_CALLBACK_QUEUE_SIZE);
-                }
-
-                for (size_t i = 0; i < dropCount && !callbackQueue_.empty(); ++i)
-                {
-                    callbackQueue_.pop();
-                }
+                return; // Nothing visible changed
             }
+            patchData = core::DataConverter::convertOrderBookDiff(view, patch);
+        }
+        callback(patchData);
+    }
 
-            // Move OrderBookMessageData into lambda to avoid copy (fixes memory leak)
-            callbackQueue_.push(CallbackTask{[orderBookData = std::move(orderBookData), callback]()
-                                             {
-                                                 try
-                                                 {
-                                                     callback(orderBookData);
-                                                 }
-                                                 catch (const std::exception &e)
-                                                 {
-                                                     std::cerr << "[C++ ERROR] OrderBook callback exception: " << e.what() << std::endl;
-                                                 }
-                                             }});
+    void TpSdkCppHybrid::queueOrderBookResyncCallback(std::string symbol, TpSdkCppHybrid *instance)
+    {
+        if (instance == nullptr)
+        {
+            return;
+        }
+
+        std::function<void(const std::string &)> callback;
+        {
+            std::lock_guard<std::mutex> callbackLock(instance->orderBookResyncCallbackMutex_);
+            if (!instance->orderBookResyncCallback_)
+            {
+                return; // Deltas are applied unsequenced meanwhile (OrderBookSync::onDepth)
+            }
+            callback = instance->orderBookResyncCallback_;
         }
+
+        // One pending request per symbol, next to (not replacing) its book updates
+        std::string key = "resync|" + symbol;
+        callbackLanes_.push(core::CallbackLane::ORDER_BOOK, [symbol = std::move(symbol), callback]()
+                            {
+                                try
+                                {
+                                    callback(symbol);
+                                }
+                                catch (const std::exception &e)
+                                {
+                                    std::cerr << "[C++ ERROR] OrderBook resync callback exception: " << e.what() << std::endl;
+                                } }, std::move(key));
+
+        schedulePushDelivery(instance);
     }
 
     void TpSdkCppHybrid::queueMiniTickerCallback(TickerMessageData tickerData, TpSdkCppHybrid *instance)
@@ -350,22 +706,20 @@ namespace margelo::nitro::cxpmobile_tpsdk
             callback = instance->miniTickerCallback_;
         }
 
-        // More aggressive queue management for ticker (9 strings per message)
-        manageCallbackQueueSize(2);
-        {
-            std::lock_guard<std::mutex> queueLock(callbackQueueMutex_);
-            callbackQueue_.push(CallbackTask{[tickerData = std::move(tickerData), callback]()
-                                             {
-                                                 try
-                                                 {
-                                                     callback(tickerData);
-                                                 }
-                                                 catch (const std::exception &e)
-                                                 {
-                                                     std::cerr << "[C++ ERROR] MiniTicker callback exception: " << e.what() << std::endl;
-                                                 }
-                                             }});
-        }
+        // Latest ticker per symbol and event type (24hrTicker and miniTicker carry different fields)
+        std::string key = tickerData.stream + '|' + tickerData.data.eventType;
+        callbackLanes_.push(core::CallbackLane::TICKER, [tickerData = std::move(tickerData), callback]()
+                            {
+                                try
+                                {
+                                    callback(tickerData);
+                                }
+                                catch (const std::exception &e)
+                                {
+                                    std::cerr << "[C++ ERROR] MiniTicker callback exception: " << e.what() << std::endl;
+                                } }, std::move(key));
+
+        schedulePushDelivery(instance);
     }
 
     void TpSdkCppHybrid::queueMiniTickerPairCallback(std::vector<TickerMessageData> tickerData, TpSdkCppHybrid *instance)
@@ -385,23 +739,19 @@ namespace margelo::nitro::cxpmobile_tpsdk
             callback = instance->miniTickerPairCallback_;
         }
 
-        // Most aggressive queue management for ticker pair (vector of tickers, can be very large)
-        // Each TickerMessageData has 9 strings, so a vector of 100 tickers = 900 strings
-        manageCallbackQueueSize(1);
-        {
-            std::lock_guard<std::mutex> queueLock(callbackQueueMutex_);
-            callbackQueue_.push(CallbackTask{[tickerData = std::move(tickerData), callback]()
-                                             {
-                                                 try
-                                                 {
-                                                     callback(tickerData);
-                                                 }
-                                                 catch (const std::exception &e)
-                                                 {
-                                                     std::cerr << "[C++ ERROR] MiniTicker Pair callback exception: " << e.what() << std::endl;
-                                                 }
-                                             }});
-        }
+        // Latest pair list only (each list is a full snapshot)
+        callbackLanes_.push(core::CallbackLane::MINI_TICKER_PAIR, [tickerData = std::move(tickerData), callback]()
+                            {
+                                try
+                                {
+                                    callback(tickerData);
+                                }
+                                catch (const std::exception &e)
+                                {
+                                    std::cerr << "[C++ ERROR] MiniTicker Pair callback exception: " << e.what() << std::endl;
+                                } });
+
+        schedulePushDelivery(instance);
     }
 
     void TpSdkCppHybrid::queueKlineCallback(KlineMessageData klineData, TpSdkCppHybrid *instance)
@@ -417,22 +767,20 @@ namespace margelo::nitro::cxpmobile_tpsdk
             callback = instance->klineCallback_;
         }
 
-        // More aggressive queue management for kline (7 strings + 6 optional strings per message)
-        manageCallbackQueueSize(2);
-        {
-            std::lock_guard<std::mutex> queueLock(callbackQueueMutex_);
-            callbackQueue_.push(CallbackTask{[klineData = std::move(klineData), callback]()
-                                             {
-                                                 try
-                                                 {
-                                                     callback(klineData);
-                                                 }
-                                                 catch (const std::exception &e)
-                                                 {
-                                                     std::cerr << "[C++ ERROR] Kline callback exception: " << e.what() << std::endl;
-                                                 }
-                                             }});
-        }
+        // Latest candle per stream + interval
+        std::string key = klineData.stream + '|' + klineData.data.kline.interval;
+        callbackLanes_.push(core::CallbackLane::KLINE, [klineData = std::move(klineData), callback]()
+                            {
+                                try
+                                {
+                                    callback(klineData);
+                                }
+                                catch (const std::exception &e)
+                                {
+                                    std::cerr << "[C++ ERROR] Kline callback exception: " << e.what() << std::endl;
+                                } }, std::move(key));
+
+        schedulePushDelivery(instance);
     }
 
     void TpSdkCppHybrid::queueTradeCallback(std::vector<TradeMessageData> batch, TpSdkCppHybrid *instance)
@@ -454,49 +802,19 @@ namespace margelo::nitro::cxpmobile_tpsdk
             callback = instance->tradesCallback_;
         }
 
-        // Queue callback with TradeMessageData batch - similar to orderbook pattern
-        {
-            std::lock_guard<std::mutex> queueLock(callbackQueueMutex_);
-
-            // Estimate memory size (rough estimate: each TradeMessageData can contain multiple trades)
-            // Each TradeMessageData has ~8 strings, estimate ~1KB per TradeMessageData
-            size_t estimatedMemory = callbackQueue_.size() * 5120; // 5KB per callback estimate
-            size_t batchMemory = batch.size() * 1024;              // 1KB per trade in batch
+        // Bounded append: every batch is delivered unless JS falls a whole lane behind
+        callbackLanes_.push(core::CallbackLane::TRADES, [batch = std::move(batch), callback]()
+                            {
+                                try
+                                {
+                                    callback(batch);
+                                }
+                                catch (const std::exception &e)
+                                {
+                                    std::cerr << "[C++ ERROR] Trades batch callback exception: " << e.what() << std::endl;
+                                } });
 
-            // More aggressive dropping based on memory
-            if (estimatedMemory > MAX_CALLBACK_MEMORY_BYTES || callbackQueue_.size() >= MAX_CALLBACK_QUEUE_SIZE)
-            {
-                // Drop more aggressively if memory limit exceeded
-                size_t dropCount = callbackQueue_.size() / 2; // Drop 50% by default
-                if (estimatedMemory > MAX_CALLBACK_MEMORY_BYTES * 2)
-                {
-                    dropCount = callbackQueue_.size() * 3 / 4; // Drop 75% if way over limit
-                }
-                // Also drop if queue size exceeds limit even slightly
-                if (callbackQueue_.size() > MAX_CALLBACK_QUEUE_SIZE)
-                {
-                    dropCount = std::max(dropCount, callbackQueue_.size() - MAX_CALLBACK_QUEUE_SIZE);
-                }
-
-                for (size_t i = 0; i < dropCount && !callbackQueue_.empty(); ++i)
-                {
-                    callbackQueue_.pop();
-                }
-            }
-
-            // Move batch into lambda to avoid copy (similar to orderbook pattern)
-            callbackQueue_.push(CallbackTask{[batch = std::move(batch), callback]()
-                                             {
-                                                 try
-                                                 {
-                                                     callback(batch);
-                                                 }
-                                                 catch (const std::exception &e)
-                                                 {
-                                                     std::cerr << "[C++ ERROR] Trades batch callback exception: " << e.what() << std::endl;
-                                                 }
-                                             }});
-        }
+        schedulePushDelivery(instance);
     }
 
     void TpSdkCppHybrid::queueUserDataCallback(UserMessageData userData, TpSdkCppHybrid *instance)
@@ -518,73 +836,79 @@ namespace margelo::nitro::cxpmobile_tpsdk
             callback = instance->userDataCallback_;
         }
 
-        // More aggressive queue management for userData
-        manageCallbackQueueSize(1);
-        {
-            std::lock_guard<std::mutex> queueLock(callbackQueueMutex_);
-            callbackQueue_.push(CallbackTask{[userData = std::move(userData), callback]()
-                                             {
-                                                 try
-                                                 {
-                                                     callback(userData);
-                                                 }
-                                                 catch (const std::exception &e)
-                                                 {
-                                                     std::cerr << "[C++ ERROR] UserData callback exception: " << e.what() << std::endl;
-                                                 }
-                                             }});
-        }
+        // Never dropped: order/fill notifications must all reach JS
+        callbackLanes_.push(core::CallbackLane::USER_DATA, [userData = std::move(userData), callback]()
+                            {
+                                try
+                                {
+                                    callback(userData);
+                                }
+                                catch (const std::exception &e)
+                                {
+                                    std::cerr << "[C++ ERROR] UserData callback exception: " << e.what() << std::endl;
+                                } });
+
+        schedulePushDelivery(instance);
     }
 
-    void TpSdkCppHybrid::processCallbackQueue()
+    double TpSdkCppHybrid::processCallbackQueue(std::optional<double> budgetUs)
     {
-        constexpr size_t MAX_CALLBACKS_PER_BATCH = 1; // Reduced from 2 to 1 for lower memory
-        constexpr size_t DROP_THRESHOLD = 2;          // Reduced from 5 to 2 for more aggressive dropping
-
-        std::vector<TpSdkCppHybrid::CallbackTask> callbacksToExecute;
-        size_t queueSize = 0;
+        // Time-budgeted drain: run callbacks until the budget is spent (at least one per call),
+        // so idle frame time is used and busy frames stay responsive
+        const double budget = budgetUs.has_value() && *budgetUs > 0.0 ? *budgetUs : DEFAULT_CALLBACK_BUDGET_US;
+        const auto deadline = std::chrono::steady_clock::now() +
+                              std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                  std::chrono::duration<double, std::micro>(budget));
 
+        // Push mode: callbacks queued from here on need a new JS notification
+        TpSdkCppHybrid *instance = getSingletonInstance();
+        if (instance != nullptr)
         {
-            std::lock_guard<std::mutex> lock(callbackQueueMutex_);
-            queueSize = callbackQueue_.size();
+            instance->pushDeliveryScheduled_.store(false, std::memory_order_release);
 
-            // More aggressive dropping for orderbook callbacks to prevent memory buildup
-            // OrderBookMessageData can be large (contains bids/asks arrays)
-            if (queueSize > DROP_THRESHOLD)
+            // Deliver a partial trade batch only once its oldest trade has waited BATCH_TIMEOUT_MS
+            std::lock_guard<std::mutex> lock(instance->tradesState_.mutex);
+            const auto now = std::chrono::steady_clock::now();
+            if (instance->tradesState_.timedOut(now))
             {
-                size_t dropCount = queueSize - DROP_THRESHOLD;
-                // Drop more aggressively if queue is very large
-                if (queueSize > DROP_THRESHOLD * 2)
-                {
-                    dropCount = queueSize - 1; // Keep only 1 item if way over threshold
-                }
-                for (size_t i = 0; i < dropCount && !callbackQueue_.empty(); ++i)
-                {
-                    callbackQueue_.pop();
-                }
-                queueSize = callbackQueue_.size();
-            }
-
-            size_t takeCount = std::min(queueSize, MAX_CALLBACKS_PER_BATCH);
-            callbacksToExecute.reserve(takeCount);
-            for (size_t i = 0; i < takeCount && !callbackQueue_.empty(); ++i)
-            {
-                callbacksToExecute.emplace_back(std::move(callbackQueue_.front()));
-                callbackQueue_.pop();
+                flushPendingTradesLocked(instance, now);
             }
         }
 
-        for (auto &task : callbacksToExecute)
+        // Lanes bound their own size (conflation / bounded append), nothing is dropped here
+        core::CallbackLanes::Task task;
+        while (callbackLanes_.popNext(task))
         {
             try
             {
-                task.callback();
+                task();
             }
             catch (const std::exception &e)
             {
                 std::cerr << "[C++ ERROR] Callback execution error: " << e.what() << std::endl;
             }
+
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                break;
+            }
+        }
+
+        const size_t remaining = callbackLanes_.size();
+        if (remaining > 0)
+        {
+            // Budget spent: continue in a later JS task (no-op unless push mode is enabled)
+            schedulePushDelivery(instance);
+        }
+
+        // A trade batch still forming counts as one pending callback, so JS polls again next frame
+        size_t pendingTradeBatches = 0;
+        if (instance != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(instance->tradesState_.mutex);
+            pendingTradeBatches = instance->tradesState_.pendingCount > 0 ? 1 : 0;
         }
+        return static_cast<double>(remaining + pendingTradeBatches);
     }
 
     void TpSdkCppHybrid::transferStateFrom(TpSdkCppHybrid *oldInstance)
@@ -614,7 +938,7 @@ namespace margelo::nitro::cxpmobile_tpsdk
                 instance->tradesState_.optimizeMemory();
             }
 
-            // OrderBook state is handled in RN store, no cleanup needed
+            // Order books are bounded by their depth limit, nothing to trim
 
             // Optimize kline memory
             {
@@ -642,6 +966,16 @@ namespace margelo::nitro::cxpmobile_tpsdk
         }
     }
 
+    double TpSdkCppHybrid::getDroppedFrameCount()
+    {
+        TpSdkCppHybrid *instance = getSingletonInstance();
+        if (instance == nullptr || !instance->frameIngestor_)
+        {
+            return 0.0;
+        }
+        return static_cast<double>(instance->frameIngestor_->getDropCount());
+    }
+
     bool TpSdkCppHybrid::isInitialized()
     {
         return LifecycleManager::isInitialized(this);
@@ -3,6 +3,7 @@
 #include "../nitrogen/generated/shared/c++/HybridTpSdkSpec.hpp"
 #include "Utils.hpp"
 #include "../nitrogen/generated/shared/c++/OrderBookMessageData.hpp"
+#include "../nitrogen/generated/shared/c++/OrderBookDiffMessageData.hpp"
 #include "../nitrogen/generated/shared/c++/TickerMessageData.hpp"
 #include "../nitrogen/generated/shared/c++/KlineMessageData.hpp"
 #include "../nitrogen/generated/shared/c++/UserMessageData.hpp"
@@ -11,18 +12,22 @@
 // Optimized core components
 #include "core/DataStructs.hpp"
 #include "core/StreamProcessor.hpp"
+#include "core/FrameIngestor.hpp"
 #include "core/SimdjsonParser.hpp"
 #include "core/DataConverter.hpp"
+#include "core/OrderBookSync.hpp"
+#include "core/OrderBookViewDiff.hpp"
 #include "core/MemoryDebug.hpp"
-#include <deque>
+#include "core/CallbackLanes.hpp"
+#include "core/StreamFormatCache.hpp"
 #include <string>
 #include <string_view>
+#include <span>
 #include <vector>
 #include <memory>
 #include <unordered_map>
 #include <NitroModules/Null.hpp>
 #include <functional>
-#include <queue>
 #include <thread>
 #include <mutex>
 #include <chrono>
@@ -66,6 +71,7 @@ namespace margelo::nitro::cxpmobile_tpsdk
     {
     public:
         // Forward declare nested state structs before first use
+        struct OrderBookState;
         struct TradesState;
         struct KlineState;
         struct TickerState;
@@ -75,15 +81,20 @@ namespace margelo::nitro::cxpmobile_tpsdk
         // Default values as constants
         static constexpr int DEFAULT_ORDERBOOK_MAX_ROWS = 50;
         static constexpr int DEFAULT_ORDERBOOK_DEPTH_LIMIT = 1000; // Keep 1000 levels, clear old data
-        static constexpr int DEFAULT_TRADES_MAX_ROWS = 50;
         static constexpr int DEFAULT_ORDERBOOK_BASE_DECIMALS = 5;
         static constexpr int DEFAULT_ORDERBOOK_PRICE_DISPLAY_DECIMALS = 2;
-        static constexpr const char *DEFAULT_ORDERBOOK_AGGREGATION = "0.01";
-        static constexpr size_t MAX_CALLBACK_QUEUE_SIZE = 3;                 // Reduced from 10 to prevent memory buildup
+        static constexpr const char *DEFAULT_ORDERBOOK_AGGREGATION = ""; // Raw levels: no single tick fits every symbol's price range
+        // Tick sizes whose grouped ladders every book keeps up to date (switching between them is free)
+        static constexpr const char *DEFAULT_ORDERBOOK_AGGREGATION_LEVELS[] = {"0.01", "0.1", "1", "10"};
         static constexpr size_t MAX_MESSAGE_QUEUE_SIZE = 20;                 // Small buffer for burst messages (Zustand stores final result)
-        static constexpr size_t MAX_CALLBACK_MEMORY_BYTES = 5 * 1024 * 1024; // 5MB memory limit for callback queue (reduced from 10MB)
         // Periodic cleanup interval (10 seconds - more frequent for better memory management)
         static constexpr std::chrono::milliseconds PERIODIC_CLEANUP_INTERVAL{10000};
+        // Parse-in-worker mode: JS thread only copies raw frames, ingest worker detects and parses
+        static constexpr bool DEFAULT_PARSE_IN_WORKER = true;
+        // Callback drain budget per processCallbackQueue() call when JS passes none (a quarter of a 60 Hz frame)
+        static constexpr double DEFAULT_CALLBACK_BUDGET_US = 4000.0;
+        // Shared executor mode: all stream rings drained by one pool sized to the core count
+        static constexpr bool DEFAULT_SHARED_STREAM_EXECUTOR = true;
 
         // Singleton pattern: Get the singleton instance
         // Returns the first instance created by Nitro
@@ -200,7 +211,7 @@ namespace margelo::nitro::cxpmobile_tpsdk
             }
         }
 
-        ~TpSdkCppHybrid() override = default;
+        ~TpSdkCppHybrid() override;
 
         /**
          * Process WebSocket message in C++ background thread (GLOBAL)
@@ -220,10 +231,20 @@ namespace margelo::nitro::cxpmobile_tpsdk
             const std::string &messageJson) override;
 
         /**
-         * OrderBook methods - Callback management only (state handled in RN store)
+         * OrderBook methods - books are merged natively (orderBookState_), JS receives the top rows
+         * (or row patches against the last delivered rows, diff mode) and is asked for a REST
+         * snapshot when a book needs one
          */
         void orderbookSubscribe(const std::function<void(const OrderBookMessageData &)> &callback) override;
         void orderbookUnsubscribe() override;
+        void orderbookDiffSubscribe(const std::function<void(const OrderBookDiffMessageData &)> &callback) override;
+        void orderbookDiffUnsubscribe() override;
+        void requestOrderBookKeyframe(const std::string &symbol) override;
+        void orderbookResyncSubscribe(const std::function<void(const std::string &)> &callback) override;
+        void orderbookResyncUnsubscribe() override;
+        void loadOrderBookSnapshot(const std::string &symbol, const std::string &snapshotJson) override;
+        void setOrderBookAggregation(const std::string &symbol, const std::string &aggregation) override;
+        void setOrderBookAggregationLevels(const std::string &symbol, const std::vector<std::string> &aggregations) override;
         void miniTickerSubscribe(const std::function<void(const TickerMessageData &)> &callback) override;
         void miniTickerUnsubscribe() override;
         void miniTickerPairSubscribe(const std::function<void(const std::vector<TickerMessageData> &)> &callback) override;
@@ -235,6 +256,24 @@ namespace margelo::nitro::cxpmobile_tpsdk
         void tradesSubscribe(const std::function<void(const std::vector<TradeMessageData> &)> &callback) override;
         void tradesUnsubscribe() override;
 
+        /**
+         * Push-mode delivery (opt-in alternative to RAF polling)
+         * onPending is invoked once per coalesced batch of queued callbacks;
+         * Nitro schedules it on the JS thread, which then drains with processCallbackQueue()
+         */
+        void enablePushDelivery(const std::function<void()> &onPending) override;
+        void disablePushDelivery() override;
+
+        /**
+         * Per-symbol display precision for prices/quantities (-1 = shortest round-trip)
+         */
+        void setSymbolPrecision(const std::string &symbol, double priceDecimals, double quantityDecimals) override;
+
+        /**
+         * Frames dropped by the ingest ring (ring full or frame too large) since start
+         */
+        double getDroppedFrameCount() override;
+
         // Initialization methods
         bool isInitialized() override;
         // Mark as initialized (override from HybridTpSdkSpec)
@@ -247,15 +286,29 @@ namespace margelo::nitro::cxpmobile_tpsdk
         // Public to allow processors (namespace functions) to access
         static void routeMessageToQueue(const std::string &messageJson, TpSdkCppHybrid *instance);
 
+        // Helper: Parse into the processor for type (false only if the message failed to parse)
+        static bool pushToProcessor(core::MessageType type, const std::string &messageJson, TpSdkCppHybrid *instance);
+        static bool pushMiniTickerArray(const std::string &messageJson, TpSdkCppHybrid *instance);
+
         // Helper: Queue callbacks
         // Public to allow processors (namespace functions) to access
-        static void queueOrderBookCallback(OrderBookMessageData &&orderBookData, TpSdkCppHybrid *instance);
+        static void queueOrderBookCallback(std::vector<OrderBookMessageData> &&batch, TpSdkCppHybrid *instance);
+        static void queueOrderBookResyncCallback(std::string symbol, TpSdkCppHybrid *instance);
+
+        // Helper: Patch against symbol's last delivered view, sent to the diff callback (JS thread, at delivery)
+        static void deliverOrderBookDiff(const OrderBookMessageData &view, const std::function<void(const OrderBookDiffMessageData &)> &callback);
         static void queueMiniTickerCallback(TickerMessageData tickerData, TpSdkCppHybrid *instance);
         static void queueMiniTickerPairCallback(std::vector<TickerMessageData> tickerData, TpSdkCppHybrid *instance);
         static void queueKlineCallback(KlineMessageData klineData, TpSdkCppHybrid *instance);
         static void queueTradeCallback(std::vector<TradeMessageData> batch, TpSdkCppHybrid *instance);
         static void queueUserDataCallback(UserMessageData userData, TpSdkCppHybrid *instance);
 
+        // Helper: Flush adaptively batched trades as one callback (caller holds tradesState_.mutex)
+        static void flushPendingTradesLocked(TpSdkCppHybrid *instance, std::chrono::steady_clock::time_point now);
+
+        // Helper: Schedule one JS drain for pending callbacks (push mode only, coalesced)
+        static void schedulePushDelivery(TpSdkCppHybrid *instance);
+
         // Pre-allocated buffers for all streams (reused to avoid malloc/free)
         // Public for MessageProcessor access
         struct PreAllocatedBuffers
@@ -294,7 +347,11 @@ namespace margelo::nitro::cxpmobile_tpsdk
         // Thread-local buffers (public for WebSocketMessageProcessor access)
         static thread_local PreAllocatedBuffers threadLocalBuffers_;
 
-        // Object pools removed - no longer used (optimized processors use core::ObjectPool)
+        // Object pools removed - no longer used (optimized processors parse into their ring's staging item)
+
+        // Shared executor for stream processors (null in dedicated-thread mode)
+        // Declared before processors: they post drain tasks to it, so it must be destroyed last
+        std::unique_ptr<ThreadPool> streamPool_;
 
         // Optimized stream processors (new system)
         std::unique_ptr<core::DepthProcessor> depthProcessor_;
@@ -304,31 +361,42 @@ namespace margelo::nitro::cxpmobile_tpsdk
         std::unique_ptr<core::KlineProcessor> klineProcessor_;
         std::unique_ptr<core::UserDataProcessor> userDataProcessor_;
 
-    private:
-        // Callback task for async dispatch to JS thread
-        struct CallbackTask
-        {
-            std::function<void()> callback;
-        };
+        // Raw frame ingest (parse-in-worker mode), null when parsing on the caller thread
+        // Declared after processors: it routes into them, so it must be destroyed first
+        std::unique_ptr<core::RawFrameIngestor> frameIngestor_;
 
-        // Callback queue
-        static std::queue<CallbackTask> callbackQueue_;
-        static std::mutex callbackQueueMutex_;
+    private:
+        // Callback lanes for async dispatch to JS thread (one lane per stream, explicit drop policy)
+        static core::CallbackLanes callbackLanes_;
 
         // Singleton instance (shared across all instances)
         static TpSdkCppHybrid *singletonInstance_;
         static std::mutex singletonMutex_;
 
         // Process callback queue (called from JS thread)
-        void processCallbackQueue() override;
+        // Runs callbacks until budgetUs is spent, returns number still queued
+        // (a trade batch waiting for its timeout counts as one)
+        double processCallbackQueue(std::optional<double> budgetUs) override;
 
     private:
         // Initialize optimized processors
         void initializeOptimizedProcessors();
 
+        // Stop ingest worker and processors (before members they call into are destroyed)
+        void shutdownOptimizedProcessors();
+
+        // Ingest worker: detect type and parse one raw frame
+        void onRawFrame(std::string_view frame);
+
+        // Ingest-thread-only buffer for the frame being routed (capacity reused)
+        std::string ingestFrameBuffer_;
+
+        // Set by the JS thread when the ingest ring drops a frame, handled by the ingest worker
+        std::atomic<bool> frameDropPending_{false};
+
         // Callbacks for optimized processors
-        void onOptimizedDepthUpdate(const core::DepthData &data);
-        void onOptimizedTradeUpdate(const core::TradeData &data);
+        void onOptimizedDepthBatch(std::span<const core::DepthData> batch);
+        void onOptimizedTradeBatch(std::span<const core::TradeData> batch);
         void onOptimizedTickerUpdate(const core::TickerData &data);
         void onOptimizedMiniTickerUpdate(const core::MiniTickerData &data);
         void onOptimizedKlineUpdate(const core::KlineData &data);
@@ -342,59 +410,187 @@ namespace margelo::nitro::cxpmobile_tpsdk
         // Clear all data in old instance when reloading (for app reload)
         void clearOldInstanceData(TpSdkCppHybrid *oldInstance);
 
-        // Helper: Manage callback queue size (drop old callbacks if needed)
-        static void manageCallbackQueueSize(size_t dropRatio = 4);
-
         // Periodic cleanup: Clear stale data and optimize memory
         // Should be called periodically (e.g., every 30 seconds)
         void performPeriodicCleanup();
 
     public:
+        struct OrderBookState
+        {
+            struct AggregationConfig
+            {
+                std::vector<core::Decimal> levels; // Tick sizes kept as grouped ladders
+                core::Decimal selected;            // Grouping sent to orderBookCallback_ (zero = raw levels)
+            };
+
+            std::unordered_map<std::string, core::OrderBookSync> books;        // symbol -> sequence-checked L2 book
+            std::unordered_map<std::string, AggregationConfig> aggregations; // symbol -> grouping (absent = defaults)
+            AggregationConfig defaultAggregation;
+            int maxRows;    // Levels per side sent to orderBookCallback_
+            int depthLimit; // Levels per side kept in each book
+            std::mutex mutex;
+
+            OrderBookState() : maxRows(DEFAULT_ORDERBOOK_MAX_ROWS), depthLimit(DEFAULT_ORDERBOOK_DEPTH_LIMIT)
+            {
+                for (const char *level : DEFAULT_ORDERBOOK_AGGREGATION_LEVELS)
+                {
+                    core::Decimal tick;
+                    if (core::Decimal::parse(level, tick))
+                    {
+                        defaultAggregation.levels.push_back(tick);
+                    }
+                }
+
+                // Selected grouping is always maintained
+                core::Decimal selected;
+                if (core::Decimal::parse(DEFAULT_ORDERBOOK_AGGREGATION, selected) && selected.isPositive())
+                {
+                    defaultAggregation.selected = selected;
+                    if (std::find(defaultAggregation.levels.begin(), defaultAggregation.levels.end(), selected) == defaultAggregation.levels.end())
+                    {
+                        defaultAggregation.levels.push_back(selected);
+                    }
+                }
+            }
+
+            const AggregationConfig &aggregationFor(std::string_view symbol) const
+            {
+                auto it = aggregations.find(std::string(symbol));
+                return it != aggregations.end() ? it->second : defaultAggregation;
+            }
+
+            core::OrderBookSync &book(std::string_view symbol)
+            {
+                auto it = books.find(std::string(symbol));
+                if (it == books.end())
+                {
+                    it = books.emplace(std::string(symbol), core::OrderBookSync(static_cast<size_t>(depthLimit))).first;
+                    it->second.setAggregations(aggregationFor(symbol).levels);
+                }
+                return it->second;
+            }
+
+            void clear()
+            {
+                books.clear();
+                books.rehash(0);
+            }
+        };
+
+        struct OrderBookDiffState
+        {
+            std::unordered_map<std::string, core::OrderBookViewDiff> views; // symbol -> last delivered view
+            std::mutex mutex;
+
+            core::OrderBookViewDiff &view(const std::string &symbol)
+            {
+                return views.try_emplace(symbol).first->second;
+            }
+
+            void clear()
+            {
+                views.clear();
+            }
+        };
+
         struct TradesState
         {
-            std::deque<TradeMessageData> queue;
-            int maxRows;
             std::mutex mutex;
 
             // Batch state for adaptive batching
-            std::deque<TradeMessageData> pendingTrades;
+            // One pending message per symbol, trades are appended to its data
+            std::vector<TradeMessageData> pendingTrades;
+            size_t pendingCount = 0;                              // Trades across all pending messages
+            std::chrono::steady_clock::time_point firstPendingTime; // Arrival of the oldest pending trade
             std::chrono::steady_clock::time_point lastFlushTime;
-            static constexpr size_t MAX_BATCH_SIZE = 10;
-            static constexpr int BATCH_TIMEOUT_MS = 20;
-            static constexpr size_t BURST_THRESHOLD = 50;
+            static constexpr size_t MAX_BATCH_SIZE = 10;   // Flush size in normal flow
+            static constexpr int BATCH_TIMEOUT_MS = 20;    // Max age of the oldest pending trade
+            static constexpr size_t BURST_THRESHOLD = 50;  // Trades per BATCH_TIMEOUT_MS window that count as a burst (also burst flush size)
             static constexpr int PENDING_TRADES_TIMEOUT_MS = 5000; // Clear pending trades if not flushed for 5 seconds
 
-            TradesState() : maxRows(DEFAULT_TRADES_MAX_ROWS),
-                            lastFlushTime(std::chrono::steady_clock::now()) {}
+            // Burst detection: arrivals in the current BATCH_TIMEOUT_MS window
+            std::chrono::steady_clock::time_point rateWindowStart;
+            size_t rateWindowCount = 0;
+            bool bursting = false;
 
-            // Optimize memory by rebuilding queue if it has grown too large
-            // std::deque doesn't have shrink_to_fit, so we rebuild if capacity is excessive
-            void optimizeMemory()
+            TradesState() : lastFlushTime(std::chrono::steady_clock::now()),
+                            rateWindowStart(lastFlushTime) {}
+
+            // Current flush size: larger batches while a burst is in progress
+            size_t batchLimit() const
+            {
+                return bursting ? BURST_THRESHOLD : MAX_BATCH_SIZE;
+            }
+
+            // Track arrival rate (call once per incoming batch)
+            void noteArrivals(size_t count, std::chrono::steady_clock::time_point now)
             {
-                // Rebuild queue if it's much smaller than maxRows to reduce memory
-                if (queue.size() < static_cast<size_t>(maxRows) / 2 && queue.size() > 0)
+                if (now - rateWindowStart >= std::chrono::milliseconds(BATCH_TIMEOUT_MS))
                 {
-                    std::deque<TradeMessageData> newQueue;
-                    // Move elements to new deque to potentially reduce internal fragmentation
-                    for (auto &item : queue)
-                    {
-                        newQueue.push_back(std::move(item));
-                    }
-                    queue = std::move(newQueue);
+                    bursting = rateWindowCount >= BURST_THRESHOLD;
+                    rateWindowStart = now;
+                    rateWindowCount = 0;
+                }
+                rateWindowCount += count;
+                if (rateWindowCount >= BURST_THRESHOLD)
+                {
+                    bursting = true;
+                }
+            }
+
+            // Append a trade to its symbol's pending message
+            void addPending(TradeDataItem &&item, std::chrono::steady_clock::time_point now)
+            {
+                if (pendingCount == 0)
+                {
+                    firstPendingTime = now;
                 }
 
-                // Also optimize pendingTrades if it has grown too large
-                if (pendingTrades.size() > MAX_BATCH_SIZE * 2 && pendingTrades.size() > 0)
+                auto it = std::find_if(pendingTrades.begin(), pendingTrades.end(),
+                                       [&item](const TradeMessageData &pending)
+                                       { return pending.stream == item.symbol; });
+                if (it == pendingTrades.end())
                 {
-                    std::deque<TradeMessageData> newPending;
-                    // Keep only recent items (last MAX_BATCH_SIZE * 2)
-                    size_t keepCount = std::min(pendingTrades.size(), static_cast<size_t>(MAX_BATCH_SIZE * 2));
-                    auto startIt = pendingTrades.end() - keepCount;
-                    for (auto it = startIt; it != pendingTrades.end(); ++it)
-                    {
-                        newPending.push_back(std::move(*it));
-                    }
-                    pendingTrades = std::move(newPending);
+                    TradeMessageData message;
+                    message.stream = item.symbol;
+                    message.wsTime = 0.0; // TradeData doesn't have wsTime
+                    message.dsTime = 0.0;
+                    message.data.reserve(batchLimit());
+                    pendingTrades.push_back(std::move(message));
+                    it = pendingTrades.end() - 1;
+                }
+                it->data.push_back(std::move(item));
+                ++pendingCount;
+            }
+
+            // Oldest pending trade has waited BATCH_TIMEOUT_MS
+            bool timedOut(std::chrono::steady_clock::time_point now) const
+            {
+                return pendingCount > 0 && now - firstPendingTime >= std::chrono::milliseconds(BATCH_TIMEOUT_MS);
+            }
+
+            // Flush on size (adaptive limit) or timeout (oldest pending trade too old)
+            bool shouldFlush(std::chrono::steady_clock::time_point now) const
+            {
+                return pendingCount >= batchLimit() || timedOut(now);
+            }
+
+            // Take all pending messages (one per symbol) for a single callback
+            std::vector<TradeMessageData> takePending(std::chrono::steady_clock::time_point now)
+            {
+                std::vector<TradeMessageData> batch;
+                batch.swap(pendingTrades);
+                pendingCount = 0;
+                lastFlushTime = now;
+                return batch;
+            }
+
+            // Release pendingTrades capacity left over from a burst (flushes swap it out)
+            void optimizeMemory()
+            {
+                if (pendingTrades.empty() && pendingTrades.capacity() > 0)
+                {
+                    pendingTrades.shrink_to_fit();
                 }
             }
 
@@ -412,6 +608,7 @@ namespace margelo::nitro::cxpmobile_tpsdk
                 if (elapsed >= PENDING_TRADES_TIMEOUT_MS)
                 {
                     pendingTrades.clear();
+                    pendingCount = 0;
                     lastFlushTime = now;
                     return true;
                 }
@@ -421,11 +618,11 @@ namespace margelo::nitro::cxpmobile_tpsdk
 
             void clear()
             {
-                queue.clear();
                 pendingTrades.clear();
+                pendingCount = 0;
+                bursting = false;
+                rateWindowCount = 0;
                 lastFlushTime = std::chrono::steady_clock::now();
-                // After clear, deque should release memory, but we can't force it
-                // The destructor will handle it
             }
         };
 
@@ -483,7 +680,9 @@ namespace margelo::nitro::cxpmobile_tpsdk
         };
 
         // Single-symbol state (direct members, no map needed)
-        // Note: OrderBookState removed - state is now handled in RN store
+        OrderBookState orderBookState_; // Deltas are merged here, JS only receives the top rows
+        // Views delivered to JS in diff mode; static like callbackLanes_, whose queued tasks use it
+        static OrderBookDiffState orderBookDiffState_;
         TradesState tradesState_;
         KlineState klineState_;
         TickerState tickerState_;
@@ -494,6 +693,14 @@ namespace margelo::nitro::cxpmobile_tpsdk
         std::function<void(const OrderBookMessageData &)> orderBookCallback_;
         std::mutex orderBookCallbackMutex_;
 
+        // Diff mode: row patches against the previously delivered view (orderBookDiffState_)
+        std::function<void(const OrderBookDiffMessageData &)> orderBookDiffCallback_;
+        std::mutex orderBookDiffCallbackMutex_;
+
+        // Resync request: symbol whose book needs a REST snapshot (loadOrderBookSnapshot)
+        std::function<void(const std::string &)> orderBookResyncCallback_;
+        std::mutex orderBookResyncCallbackMutex_;
+
         std::function<void(const TickerMessageData &)> miniTickerCallback_;
         std::mutex miniTickerCallbackMutex_;
 
@@ -509,6 +716,12 @@ namespace margelo::nitro::cxpmobile_tpsdk
         std::function<void(const std::vector<TradeMessageData> &)> tradesCallback_;
         std::mutex tradesCallbackMutex_;
 
+        // Push-mode delivery: JS drain notification, set while a notification is in flight
+        std::function<void()> pushDeliveryCallback_;
+        std::mutex pushDeliveryMutex_;
+        std::atomic<bool> pushDeliveryEnabled_{false};
+        std::atomic<bool> pushDeliveryScheduled_{false};
+
         // Global all tickers state (for !miniTicker@arr)
         std::vector<TickerMessageData> allTickersData_;
         std::mutex allTickersMutex_;
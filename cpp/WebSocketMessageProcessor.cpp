@@ -2,6 +2,7 @@
 #include "helpers/JsonHelpers.hpp"
 #include "TpSdkCppHybrid.hpp"
 #include "Utils.hpp"
+#include "core/PaddedArena.hpp"
 #include <sstream>
 #include <algorithm>
 #include <cctype>
@@ -13,27 +14,12 @@ namespace margelo::nitro::cxpmobile_tpsdk
     std::unique_ptr<WebSocketMessageResultNitro> WebSocketMessageProcessor::processMessage(
         const std::string &messageJson)
     {
-        // Use thread-local parser and buffer for simdjson to reduce allocations
+        // Use thread-local parser; input is padded once (in place or via the thread's arena)
+        // and the same view is re-iterated below
         thread_local simdjson::ondemand::parser parser;
-        thread_local simdjson::padded_string paddedJsonBuffer;
-        // Track buffer size to avoid unnecessary reallocation
-        thread_local size_t paddedBufferSize = 0;
+        const simdjson::padded_string_view paddedJson = core::PaddedArena::local().prepare(messageJson);
 
-        // OPTIMIZATION: Only reallocate if current buffer is too small
-        // padded_string doesn't expose capacity(), so we track size ourselves
-        if (paddedBufferSize < messageJson.size() + simdjson::SIMDJSON_PADDING)
-        {
-            // Need to reallocate - create new padded_string
-            paddedJsonBuffer = simdjson::padded_string(messageJson);
-            paddedBufferSize = messageJson.size() + simdjson::SIMDJSON_PADDING;
-        }
-        else
-        {
-            // Reuse existing buffer - assignment operator will copy data efficiently
-        paddedJsonBuffer = messageJson;
-        }
-
-        auto docResult = parser.iterate(paddedJsonBuffer);
+        auto docResult = parser.iterate(paddedJson);
 
         if (docResult.error() != simdjson::SUCCESS)
         {
@@ -175,16 +161,7 @@ namespace margelo::nitro::cxpmobile_tpsdk
             }
             else
             {
-                if (paddedBufferSize < messageJson.size() + simdjson::SIMDJSON_PADDING)
-                {
-                    paddedJsonBuffer = simdjson::padded_string(messageJson);
-                    paddedBufferSize = messageJson.size() + simdjson::SIMDJSON_PADDING;
-                }
-                else
-                {
-                    paddedJsonBuffer = messageJson;
-                }
-                auto docResult2 = parser.iterate(paddedJsonBuffer);
+                auto docResult2 = parser.iterate(paddedJson);
                 if (docResult2.error() == simdjson::SUCCESS)
                 {
                     simdjson::ondemand::document &doc2 = docResult2.value();
@@ -204,16 +181,7 @@ namespace margelo::nitro::cxpmobile_tpsdk
         case WebSocketMessageType::DEPTH:
             if (isBinance)
             {
-                if (paddedBufferSize < messageJson.size() + simdjson::SIMDJSON_PADDING)
-                {
-                    paddedJsonBuffer = simdjson::padded_string(messageJson);
-                    paddedBufferSize = messageJson.size() + simdjson::SIMDJSON_PADDING;
-            }
-            else
-            {
-                    paddedJsonBuffer = messageJson;
-                }
-                auto docResultBinance = parser.iterate(paddedJsonBuffer);
+                auto docResultBinance = parser.iterate(paddedJson);
                 if (docResultBinance.error() == simdjson::SUCCESS)
                 {
                     simdjson::ondemand::document &docBinance = docResultBinance.value();
@@ -226,16 +194,7 @@ namespace margelo::nitro::cxpmobile_tpsdk
             }
             else
             {
-                if (paddedBufferSize < messageJson.size() + simdjson::SIMDJSON_PADDING)
-                {
-                    paddedJsonBuffer = simdjson::padded_string(messageJson);
-                    paddedBufferSize = messageJson.size() + simdjson::SIMDJSON_PADDING;
-                }
-                else
-                {
-                    paddedJsonBuffer = messageJson;
-                }
-                auto docResultCXP = parser.iterate(paddedJsonBuffer);
+                auto docResultCXP = parser.iterate(paddedJson);
                 if (docResultCXP.error() == simdjson::SUCCESS)
                 {
                     simdjson::ondemand::document &docCXP = docResultCXP.value();
@@ -256,16 +215,7 @@ namespace margelo::nitro::cxpmobile_tpsdk
             if (isBinance)
             {
                 // Re-parse document for Binance parsing to avoid invalidation issues
-                if (paddedBufferSize < messageJson.size() + simdjson::SIMDJSON_PADDING)
-                {
-                    paddedJsonBuffer = simdjson::padded_string(messageJson);
-                    paddedBufferSize = messageJson.size() + simdjson::SIMDJSON_PADDING;
-            }
-            else
-            {
-                    paddedJsonBuffer = messageJson;
-                }
-                auto docResultBinance = parser.iterate(paddedJsonBuffer);
+                auto docResultBinance = parser.iterate(paddedJson);
                 if (docResultBinance.error() == simdjson::SUCCESS)
                 {
                     simdjson::ondemand::document &docBinance = docResultBinance.value();
@@ -279,16 +229,7 @@ namespace margelo::nitro::cxpmobile_tpsdk
             else
             {
                 // CXP format - re-parse if document might be invalidated
-                if (paddedBufferSize < messageJson.size() + simdjson::SIMDJSON_PADDING)
-                {
-                    paddedJsonBuffer = simdjson::padded_string(messageJson);
-                    paddedBufferSize = messageJson.size() + simdjson::SIMDJSON_PADDING;
-                }
-                else
-                {
-                    paddedJsonBuffer = messageJson;
-                }
-                auto docResultCXP = parser.iterate(paddedJsonBuffer);
+                auto docResultCXP = parser.iterate(paddedJson);
                 if (docResultCXP.error() == simdjson::SUCCESS)
                 {
                     simdjson::ondemand::document &docCXP = docResultCXP.value();
@@ -304,16 +245,7 @@ namespace margelo::nitro::cxpmobile_tpsdk
             if (isBinance)
             {
                 // Re-parse document for Binance parsing to avoid invalidation issues
-                if (paddedBufferSize < messageJson.size() + simdjson::SIMDJSON_PADDING)
-                {
-                    paddedJsonBuffer = simdjson::padded_string(messageJson);
-                    paddedBufferSize = messageJson.size() + simdjson::SIMDJSON_PADDING;
-            }
-            else
-            {
-                    paddedJsonBuffer = messageJson;
-                }
-                auto docResultBinance = parser.iterate(paddedJsonBuffer);
+                auto docResultBinance = parser.iterate(paddedJson);
                 if (docResultBinance.error() == simdjson::SUCCESS)
                 {
                     simdjson::ondemand::document &docBinance = docResultBinance.value();
@@ -327,16 +259,7 @@ namespace margelo::nitro::cxpmobile_tpsdk
             else
             {
                 // CXP format - re-parse if document might be invalidated
-                if (paddedBufferSize < messageJson.size() + simdjson::SIMDJSON_PADDING)
-                {
-                    paddedJsonBuffer = simdjson::padded_string(messageJson);
-                    paddedBufferSize = messageJson.size() + simdjson::SIMDJSON_PADDING;
-                }
-                else
-                {
-                    paddedJsonBuffer = messageJson;
-                }
-                auto docResultCXP = parser.iterate(paddedJsonBuffer);
+                auto docResultCXP = parser.iterate(paddedJson);
                 if (docResultCXP.error() == simdjson::SUCCESS)
                 {
                     simdjson::ondemand::document &docCXP = docResultCXP.value();
@@ -352,16 +275,7 @@ namespace margelo::nitro::cxpmobile_tpsdk
             if (isBinance)
             {
                 // Re-parse document for Binance parsing to avoid invalidation issues
-                if (paddedBufferSize < messageJson.size() + simdjson::SIMDJSON_PADDING)
-                {
-                    paddedJsonBuffer = simdjson::padded_string(messageJson);
-                    paddedBufferSize = messageJson.size() + simdjson::SIMDJSON_PADDING;
-            }
-            else
-            {
-                    paddedJsonBuffer = messageJson;
-                }
-                auto docResultBinance = parser.iterate(paddedJsonBuffer);
+                auto docResultBinance = parser.iterate(paddedJson);
                 if (docResultBinance.error() == simdjson::SUCCESS)
                 {
                     simdjson::ondemand::document &docBinance = docResultBinance.value();
@@ -375,16 +289,7 @@ namespace margelo::nitro::cxpmobile_tpsdk
             else
             {
                 // CXP format - re-parse if document might be invalidated
-                if (paddedBufferSize < messageJson.size() + simdjson::SIMDJSON_PADDING)
-                {
-                    paddedJsonBuffer = simdjson::padded_string(messageJson);
-                    paddedBufferSize = messageJson.size() + simdjson::SIMDJSON_PADDING;
-                }
-                else
-                {
-                    paddedJsonBuffer = messageJson;
-                }
-                auto docResultCXP = parser.iterate(paddedJsonBuffer);
+                auto docResultCXP = parser.iterate(paddedJson);
                 if (docResultCXP.error() == simdjson::SUCCESS)
                 {
                     simdjson::ondemand::document &docCXP = docResultCXP.value();
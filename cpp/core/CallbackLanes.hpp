@@ -0,0 +1,228 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * Callback lanes, in drain priority order (highest first)
+     */
+    enum class CallbackLane : uint8_t
+    {
+        USER_DATA = 0,    // Order/fill notifications - never dropped
+        ORDER_BOOK,       // Latest book per symbol
+        TRADES,           // Bounded append (oldest batch dropped when full)
+        TICKER,           // Latest ticker per symbol
+        MINI_TICKER_PAIR, // Latest pair list
+        KLINE,            // Latest candle per stream + interval
+        COUNT
+    };
+
+    /**
+     * How a lane handles updates that JS has not consumed yet
+     */
+    enum class LanePolicy : uint8_t
+    {
+        NEVER_DROP,      // Unbounded FIFO
+        CONFLATE_LATEST, // One pending task per key, newer task replaces older in place
+        BOUNDED_APPEND   // FIFO with capacity, oldest dropped when full
+    };
+
+    /**
+     * Per-stream callback lanes for delivery to the JS thread
+     *
+     * Features:
+     * - One lane per stream with an explicit policy, so a burst on one stream
+     *   can never evict another stream's updates
+     * - Conflated lanes keep the pending task's queue position and replace its
+     *   payload, so a busy symbol doesn't starve quieter ones
+     * - popNext() drains lanes in priority order (user data first)
+     * - Per-lane drop/conflation counters
+     */
+    class CallbackLanes
+    {
+    public:
+        using Task = std::function<void()>;
+
+        static constexpr size_t LANE_COUNT = static_cast<size_t>(CallbackLane::COUNT);
+        static constexpr size_t DEFAULT_TRADES_LANE_CAPACITY = 32; // Pending trade batches
+
+    private:
+        struct Entry
+        {
+            std::string key;
+            Task task;
+        };
+
+        struct Lane
+        {
+            LanePolicy policy = LanePolicy::NEVER_DROP;
+            size_t capacity = 0; // BOUNDED_APPEND only
+
+            std::deque<Entry> entries;
+            uint64_t frontSeq = 0;                           // Sequence number of entries.front()
+            std::unordered_map<std::string, uint64_t> keyed; // CONFLATE_LATEST: key -> sequence number
+
+            uint64_t dropCount = 0;
+            uint64_t conflateCount = 0;
+
+            void popFront()
+            {
+                if (policy == LanePolicy::CONFLATE_LATEST)
+                {
+                    keyed.erase(entries.front().key);
+                }
+                entries.pop_front();
+                ++frontSeq;
+            }
+
+            void clear()
+            {
+                frontSeq += entries.size();
+                entries.clear();
+                keyed.clear();
+            }
+        };
+
+        std::array<Lane, LANE_COUNT> lanes_;
+        mutable std::mutex mutex_;
+
+        Lane &lane(CallbackLane id) { return lanes_[static_cast<size_t>(id)]; }
+
+    public:
+        CallbackLanes()
+        {
+            lane(CallbackLane::USER_DATA).policy = LanePolicy::NEVER_DROP;
+            lane(CallbackLane::ORDER_BOOK).policy = LanePolicy::CONFLATE_LATEST;
+            lane(CallbackLane::TRADES).policy = LanePolicy::BOUNDED_APPEND;
+            lane(CallbackLane::TRADES).capacity = DEFAULT_TRADES_LANE_CAPACITY;
+            lane(CallbackLane::TICKER).policy = LanePolicy::CONFLATE_LATEST;
+            lane(CallbackLane::MINI_TICKER_PAIR).policy = LanePolicy::CONFLATE_LATEST;
+            lane(CallbackLane::KLINE).policy = LanePolicy::CONFLATE_LATEST;
+        }
+
+        // Non-copyable, non-movable
+        CallbackLanes(const CallbackLanes &) = delete;
+        CallbackLanes &operator=(const CallbackLanes &) = delete;
+        CallbackLanes(CallbackLanes &&) = delete;
+        CallbackLanes &operator=(CallbackLanes &&) = delete;
+
+        /**
+         * Queue a task on a lane
+         * key is only used by CONFLATE_LATEST lanes (pending task with same key is replaced)
+         * Returns false if an older pending task was dropped or replaced
+         */
+        bool push(CallbackLane id, Task task, std::string key = {})
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Lane &target = lane(id);
+
+            switch (target.policy)
+            {
+            case LanePolicy::CONFLATE_LATEST:
+            {
+                auto it = target.keyed.find(key);
+                if (it != target.keyed.end())
+                {
+                    target.entries[it->second - target.frontSeq].task = std::move(task);
+                    ++target.conflateCount;
+                    return false;
+                }
+                target.keyed.emplace(key, target.frontSeq + target.entries.size());
+                target.entries.push_back(Entry{std::move(key), std::move(task)});
+                return true;
+            }
+            case LanePolicy::BOUNDED_APPEND:
+            {
+                bool dropped = false;
+                while (target.capacity > 0 && target.entries.size() >= target.capacity)
+                {
+                    target.popFront();
+                    ++target.dropCount;
+                    dropped = true;
+                }
+                target.entries.push_back(Entry{std::string(), std::move(task)});
+                return !dropped;
+            }
+            case LanePolicy::NEVER_DROP:
+            default:
+                target.entries.push_back(Entry{std::string(), std::move(task)});
+                return true;
+            }
+        }
+
+        /**
+         * Take the oldest task from the highest-priority non-empty lane
+         * Returns false if all lanes are empty
+         */
+        bool popNext(Task &task)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (Lane &candidate : lanes_)
+            {
+                if (!candidate.entries.empty())
+                {
+                    task = std::move(candidate.entries.front().task);
+                    candidate.popFront();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Total pending tasks across all lanes
+         */
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            size_t total = 0;
+            for (const Lane &candidate : lanes_)
+            {
+                total += candidate.entries.size();
+            }
+            return total;
+        }
+
+        size_t size(CallbackLane id) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return lanes_[static_cast<size_t>(id)].entries.size();
+        }
+
+        /**
+         * Drop all pending tasks (e.g. on reload)
+         */
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (Lane &candidate : lanes_)
+            {
+                candidate.clear();
+            }
+        }
+
+        /**
+         * Get statistics (for debugging)
+         */
+        uint64_t getDropCount(CallbackLane id) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return lanes_[static_cast<size_t>(id)].dropCount;
+        }
+
+        uint64_t getConflateCount(CallbackLane id) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return lanes_[static_cast<size_t>(id)].conflateCount;
+        }
+    };
+}
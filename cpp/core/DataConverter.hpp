@@ -1,13 +1,21 @@
 #pragma once
 
 #include "DataStructs.hpp"
+#include "NumberFormatter.hpp"
+#include "OrderBook.hpp"
+#include "OrderBookViewDiff.hpp"
 #include "../../nitrogen/generated/shared/c++/OrderBookMessageData.hpp"
+#include "../../nitrogen/generated/shared/c++/OrderBookDiffMessageData.hpp"
+#include "../../nitrogen/generated/shared/c++/OrderBookRowOp.hpp"
+#include "../../nitrogen/generated/shared/c++/OrderBookRowOpType.hpp"
 #include "../../nitrogen/generated/shared/c++/TradeMessageData.hpp"
 #include "../../nitrogen/generated/shared/c++/TickerMessageData.hpp"
 #include "../../nitrogen/generated/shared/c++/KlineMessageData.hpp"
 #include "../../nitrogen/generated/shared/c++/KlineDataWrapper.hpp"
 #include "../../nitrogen/generated/shared/c++/UserMessageData.hpp"
+#include <algorithm>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace margelo::nitro::cxpmobile_tpsdk::core
@@ -15,78 +23,251 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
     /**
      * Convert core POD structs to Nitro-generated types
      * These functions are used to bridge between optimized core and existing Nitro API
+     * Prices/quantities are formatted with NumberFormatter using the symbol's registered
+     * precision (shortest round-trip when none is set)
      */
     class DataConverter
     {
     public:
+        static constexpr size_t DEFAULT_DEPTH_CHART_POINTS = 64; // Depth chart points per side
+
+        /**
+         * Best maxRows levels of a book side as [price, quantity] strings
+         */
+        template <bool IsBid>
+        static std::vector<std::tuple<std::string, std::string>> convertLevels(const OrderBookSide<IsBid> &side, size_t maxRows, const SymbolPrecision &precision)
+        {
+            std::vector<std::tuple<std::string, std::string>> rows;
+            const size_t count = std::min(maxRows, side.size());
+            rows.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const PriceLevel &level = side.level(i);
+                rows.emplace_back(level.price.toString(precision.priceDecimals),
+                                  level.quantity.toString(precision.quantityDecimals));
+            }
+            return rows;
+        }
+
+        /**
+         * Running quantity total of each row convertLevels sends (exact sums, best first)
+         */
+        template <bool IsBid>
+        static std::vector<double> cumulativeQuantities(const OrderBookSide<IsBid> &side, size_t maxRows)
+        {
+            std::vector<double> cumulative;
+            const size_t count = std::min(maxRows, side.size());
+            cumulative.reserve(count);
+            Decimal total;
+            for (size_t i = 0; i < count; ++i)
+            {
+                total += side.level(i).quantity;
+                cumulative.push_back(total.toDouble());
+            }
+            return cumulative;
+        }
+
+        /**
+         * Depth bar width of each row (0..1): its cumulative quantity over the largest
+         * visible cumulative quantity of either side
+         */
+        static std::vector<double> barRatios(const std::vector<double> &cumulative, double maxCumulative)
+        {
+            std::vector<double> ratios;
+            ratios.reserve(cumulative.size());
+            for (double value : cumulative)
+            {
+                ratios.push_back(maxCumulative > 0.0 ? value / maxCumulative : 0.0);
+            }
+            return ratios;
+        }
+
         /**
-         * Convert DepthData to OrderBookMessageData
+         * Depth chart of the whole side (every level the book keeps, not only the visible rows)
+         * as [price, cumulative, price, cumulative, ...]
+         * Downsampled by quantity: a point each time the cumulative crosses another
+         * 1/points of the side total, so walls keep their detail and thin tails
+         * collapse; the best and worst levels are always included
+         * Two O(levels) walks per emission, bounded by the book's depth limit
          */
-        static margelo::nitro::cxpmobile_tpsdk::OrderBookMessageData convertDepth(const DepthData &data)
+        template <bool IsBid>
+        static std::vector<double> depthChart(const OrderBookSide<IsBid> &side, size_t points)
+        {
+            std::vector<double> chart;
+            if (side.size() == 0 || points == 0)
+            {
+                return chart;
+            }
+            chart.reserve(std::min(side.size(), points + 2) * 2);
+
+            Decimal total;
+            for (size_t i = 0; i < side.size(); ++i)
+            {
+                total += side.level(i).quantity;
+            }
+
+            const double step = total.toDouble() / static_cast<double>(points);
+            double nextThreshold = 0.0;
+            Decimal cumulative;
+            const size_t last = side.size() - 1;
+            for (size_t i = 0; i <= last; ++i)
+            {
+                cumulative += side.level(i).quantity;
+                const double value = cumulative.toDouble();
+                if (i == 0 || i == last || value >= nextThreshold)
+                {
+                    chart.push_back(side.level(i).price.toDouble());
+                    chart.push_back(value);
+                    nextThreshold = value + step;
+                }
+            }
+            return chart;
+        }
+
+        /**
+         * Convert a symbol's merged book to OrderBookMessageData (best maxRows levels per side)
+         * latest supplies the metadata of the depth message applied last; a positive
+         * aggregation maintained by the book selects its grouped ladder instead of raw levels
+         * Rows come with their cumulative quantities, bar ratios and the sides' depth charts,
+         * so JS does no per-level math. They are derived at emission: cumulatives and bars
+         * from the visible rows (O(maxRows)), charts from every level of each side (O(levels));
+         * prefix sums kept in the book would cost O(levels) per update instead, since a change
+         * shifts the sums of every worse level
+         */
+        static margelo::nitro::cxpmobile_tpsdk::OrderBookMessageData convertOrderBook(const DepthData &latest, const OrderBook &book, size_t maxRows, Decimal aggregation = Decimal(),
+                                                                                      size_t chartPoints = DEFAULT_DEPTH_CHART_POINTS)
         {
             margelo::nitro::cxpmobile_tpsdk::OrderBookMessageData result;
 
             // Convert symbol
-            result.stream = std::string(data.symbol, data.symbolLen);
+            result.stream = std::string(latest.symbol, latest.symbolLen);
+            const SymbolPrecision precision = SymbolPrecisionRegistry::instance().get(result.stream);
 
-            // Convert bids
+            // Convert levels (best first)
             margelo::nitro::cxpmobile_tpsdk::OrderBookDataItem dataItem;
-            for (size_t i = 0; i < data.bidsCount; ++i)
+            const OrderBookLadder *ladder = aggregation.isPositive() ? book.ladder(aggregation) : nullptr;
+            if (ladder != nullptr)
             {
-                std::tuple<std::string, std::string> level;
-                std::get<0>(level) = std::to_string(data.bids[i].price);
-                std::get<1>(level) = std::to_string(data.bids[i].quantity);
-                dataItem.bids.push_back(std::move(level));
+                convertSides(ladder->bids(), ladder->asks(), maxRows, chartPoints, precision, dataItem);
             }
-
-            // Convert asks
-            for (size_t i = 0; i < data.asksCount; ++i)
+            else
             {
-                std::tuple<std::string, std::string> level;
-                std::get<0>(level) = std::to_string(data.asks[i].price);
-                std::get<1>(level) = std::to_string(data.asks[i].quantity);
-                dataItem.asks.push_back(std::move(level));
+                convertSides(book.bids(), book.asks(), maxRows, chartPoints, precision, dataItem);
             }
 
-            // Metadata
-            dataItem.eventType = "depthUpdate";
-            dataItem.eventTime = static_cast<double>(data.eventTime);
+            // Metadata: levels are the full merged book top, not a delta
+            dataItem.eventType = "depthSnapshot";
+            dataItem.eventTime = static_cast<double>(latest.eventTime);
             dataItem.symbol = result.stream;
-            dataItem.firstUpdateId = std::to_string(data.firstUpdateId);
-            dataItem.finalUpdateId = std::to_string(data.finalUpdateId);
-            dataItem.dsTime = static_cast<double>(data.dsTime);
+            dataItem.firstUpdateId = std::to_string(latest.isSnapshot ? latest.lastUpdateId : latest.firstUpdateId);
+            dataItem.finalUpdateId = std::to_string(book.lastUpdateId());
+            dataItem.dsTime = static_cast<double>(latest.dsTime);
 
             result.data = std::move(dataItem);
-            result.wsTime = static_cast<double>(data.wsTime);
+            result.wsTime = static_cast<double>(latest.wsTime);
 
             return result;
         }
 
         /**
-         * Convert TradeData to TradeMessageData
+         * Row ops of one side; INSERT/UPDATE carry the row's price and quantity from the view
+         * (REMOVE carries none)
          */
-        static margelo::nitro::cxpmobile_tpsdk::TradeMessageData convertTrade(const TradeData &data)
+        static std::vector<margelo::nitro::cxpmobile_tpsdk::OrderBookRowOp> convertRowOps(const std::vector<OrderBookViewDiff::Op> &ops, const OrderBookViewDiff::Rows &rows)
         {
-            margelo::nitro::cxpmobile_tpsdk::TradeMessageData result;
+            std::vector<margelo::nitro::cxpmobile_tpsdk::OrderBookRowOp> result;
+            result.reserve(ops.size());
+            for (const OrderBookViewDiff::Op &op : ops)
+            {
+                margelo::nitro::cxpmobile_tpsdk::OrderBookRowOp item;
+                item.type = static_cast<margelo::nitro::cxpmobile_tpsdk::OrderBookRowOpType>(op.type);
+                item.index = static_cast<double>(op.index);
+                if (op.type != OrderBookViewDiff::OpType::REMOVE)
+                {
+                    item.price = std::get<0>(rows[op.row]);
+                    item.quantity = std::get<1>(rows[op.row]);
+                }
+                result.push_back(std::move(item));
+            }
+            return result;
+        }
 
-            result.stream = std::string(data.symbol, data.symbolLen);
-            result.wsTime = 0.0; // TradeData doesn't have wsTime
-            result.dsTime = 0.0;
+        /**
+         * Diff-mode message: patch from OrderBookViewDiff plus the view's metadata
+         * A side's cumulative/bar ratio arrays and depth chart are only set when they
+         * changed (always on keyframes)
+         */
+        static margelo::nitro::cxpmobile_tpsdk::OrderBookDiffMessageData convertOrderBookDiff(const margelo::nitro::cxpmobile_tpsdk::OrderBookMessageData &view, const OrderBookViewDiff::Patch &patch)
+        {
+            margelo::nitro::cxpmobile_tpsdk::OrderBookDiffMessageData result;
+            result.stream = view.stream;
+            result.version = static_cast<double>(patch.version);
+            result.keyframe = patch.keyframe;
+            result.synced = view.data.synced;
+            result.bids = convertRowOps(patch.bids, view.data.bids);
+            result.asks = convertRowOps(patch.asks, view.data.asks);
+            if (patch.bidDepthChanged)
+            {
+                result.bidCumulative = view.data.bidCumulative;
+                result.bidBarRatios = view.data.bidBarRatios;
+            }
+            if (patch.askDepthChanged)
+            {
+                result.askCumulative = view.data.askCumulative;
+                result.askBarRatios = view.data.askBarRatios;
+            }
+            if (patch.bidChartChanged)
+            {
+                result.bidDepthChart = view.data.bidDepthChart;
+            }
+            if (patch.askChartChanged)
+            {
+                result.askDepthChart = view.data.askDepthChart;
+            }
+            result.eventTime = view.data.eventTime;
+            result.finalUpdateId = view.data.finalUpdateId;
+            result.wsTime = view.wsTime;
+            return result;
+        }
+
+        /**
+         * Rows, cumulative quantities and bar ratios of the best maxRows levels of both
+         * sides of a (grouped) book, plus each side's full depth chart
+         */
+        static void convertSides(const OrderBookSide<true> &bids, const OrderBookSide<false> &asks, size_t maxRows, size_t chartPoints,
+                                 const SymbolPrecision &precision, margelo::nitro::cxpmobile_tpsdk::OrderBookDataItem &dataItem)
+        {
+            dataItem.bids = convertLevels(bids, maxRows, precision);
+            dataItem.asks = convertLevels(asks, maxRows, precision);
+
+            dataItem.bidCumulative = cumulativeQuantities(bids, maxRows);
+            dataItem.askCumulative = cumulativeQuantities(asks, maxRows);
+            // Bars of both sides share one scale: the deepest visible cumulative quantity
+            const double maxCumulative = std::max(dataItem.bidCumulative.empty() ? 0.0 : dataItem.bidCumulative.back(),
+                                                  dataItem.askCumulative.empty() ? 0.0 : dataItem.askCumulative.back());
+            dataItem.bidBarRatios = barRatios(dataItem.bidCumulative, maxCumulative);
+            dataItem.askBarRatios = barRatios(dataItem.askCumulative, maxCumulative);
+
+            dataItem.bidDepthChart = depthChart(bids, chartPoints);
+            dataItem.askDepthChart = depthChart(asks, chartPoints);
+        }
 
-            // Create single trade item
+        /**
+         * Convert TradeData to a single TradeDataItem (appended to its symbol's batched TradeMessageData)
+         */
+        static margelo::nitro::cxpmobile_tpsdk::TradeDataItem convertTradeItem(const TradeData &data)
+        {
             margelo::nitro::cxpmobile_tpsdk::TradeDataItem item;
             item.eventType = "trade";
             item.eventTime = static_cast<double>(data.timestamp);
-            item.symbol = result.stream;
+            item.symbol = std::string(data.symbol, data.symbolLen);
+            const SymbolPrecision precision = SymbolPrecisionRegistry::instance().get(item.symbol);
             item.tradeId = ""; // Not available in TradeData POD
-            item.price = std::to_string(data.price);
-            item.quantity = std::to_string(data.quantity);
+            item.price = data.price.toString(precision.priceDecimals);
+            item.quantity = data.quantity.toString(precision.quantityDecimals);
             item.tradeTime = static_cast<double>(data.timestamp);
             item.isBuyerMaker = data.isBuyerMaker;
-
-            result.data.push_back(std::move(item));
-
-            return result;
+            return item;
         }
 
         /**
@@ -103,11 +284,12 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
             item.eventType = "24hrTicker";
             item.eventTime = static_cast<double>(data.eventTime);
             item.symbol = result.stream;
-            item.closePrice = std::to_string(data.lastPrice);
-            item.openPrice = std::to_string(data.open24h);
-            item.highPrice = std::to_string(data.high24h);
-            item.lowPrice = std::to_string(data.low24h);
-            item.volume = std::to_string(data.volume);
+            const SymbolPrecision precision = SymbolPrecisionRegistry::instance().get(result.stream);
+            item.closePrice = data.lastPrice.toString(precision.priceDecimals);
+            item.openPrice = data.open24h.toString(precision.priceDecimals);
+            item.highPrice = data.high24h.toString(precision.priceDecimals);
+            item.lowPrice = data.low24h.toString(precision.priceDecimals);
+            item.volume = data.volume.toString(precision.quantityDecimals);
             item.quoteVolume = "0"; // Not available in TickerData
             item.dsTime = 0.0;
 
@@ -130,8 +312,9 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
             item.eventType = "miniTicker";
             item.eventTime = static_cast<double>(data.eventTime);
             item.symbol = result.stream;
-            item.closePrice = std::to_string(data.lastPrice);
-            item.volume = std::to_string(data.volume);
+            const SymbolPrecision precision = SymbolPrecisionRegistry::instance().get(result.stream);
+            item.closePrice = data.lastPrice.toString(precision.priceDecimals);
+            item.volume = data.volume.toString(precision.quantityDecimals);
             item.dsTime = 0.0;
 
             result.data = std::move(item);
@@ -155,11 +338,12 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
             klineItem.interval = "1m"; // Default, should be extracted from stream
             klineItem.openTime = static_cast<double>(data.openTime);
             klineItem.closeTime = static_cast<double>(data.closeTime);
-            klineItem.openPrice = std::to_string(data.open);
-            klineItem.closePrice = std::to_string(data.close);
-            klineItem.highPrice = std::to_string(data.high);
-            klineItem.lowPrice = std::to_string(data.low);
-            klineItem.volume = std::to_string(data.volume);
+            const SymbolPrecision precision = SymbolPrecisionRegistry::instance().get(result.stream);
+            klineItem.openPrice = data.open.toString(precision.priceDecimals);
+            klineItem.closePrice = data.close.toString(precision.priceDecimals);
+            klineItem.highPrice = data.high.toString(precision.priceDecimals);
+            klineItem.lowPrice = data.low.toString(precision.priceDecimals);
+            klineItem.volume = data.volume.toString(precision.quantityDecimals);
             klineItem.quoteVolume = "0";        // Not available in KlineData
             klineItem.numberOfTrades = 0.0;     // Not available in KlineData
             klineItem.isClosed = false;         // Not available in KlineData
@@ -200,9 +384,10 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
             item.symbolCode = result.stream;
             item.status = std::string(data.status, data.statusLen);
             item.type = std::string(data.type, data.typeLen);
-            item.price = std::to_string(data.price);
-            item.quantity = std::to_string(data.quantity);
-            item.baseFilled = std::to_string(data.executedQty);
+            const SymbolPrecision precision = SymbolPrecisionRegistry::instance().get(result.stream);
+            item.price = data.price.toString(precision.priceDecimals);
+            item.quantity = data.quantity.toString(precision.quantityDecimals);
+            item.baseFilled = data.executedQty.toString(precision.quantityDecimals);
 
             // Note: UserDataItem has many optional fields that are not in our POD struct
             // Only set the ones we have data for
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "Decimal.hpp"
 #include <cstdint>
 #include <cstddef>
 #include <array>
+#include <vector>
 
 namespace margelo::nitro::cxpmobile_tpsdk::core
 {
@@ -10,19 +12,23 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
     // POD Data Structures - Zero overhead, cache-friendly
     // ============================================================================
 
+    // Prices and quantities are fixed-point Decimal (8 bytes, exact, parsed from the wire text)
+
+    // Price levels kept per side of one depth message (more sets levelsTruncated)
+    static constexpr size_t MAX_DEPTH_LEVELS = 100;
+
     /**
-     * Price level for orderbook (20 levels max)
-     * Using double for precision (8 bytes)
+     * Price level for orderbook
      */
     struct PriceLevel
     {
-        double price;
-        double quantity;
+        Decimal price;
+        Decimal quantity;
     };
 
     /**
      * DEPTH STREAM - Orderbook snapshot/update
-     * Only keeps 20 price levels, no string symbol
+     * Keeps up to MAX_DEPTH_LEVELS price levels per side, no string symbol
      */
     struct DepthData
     {
@@ -30,22 +36,59 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
         char symbol[16];
         uint8_t symbolLen; // Actual length
 
-        // Price levels (max 20)
-        std::array<PriceLevel, 20> bids;
-        std::array<PriceLevel, 20> asks;
+        // Price levels (max MAX_DEPTH_LEVELS)
+        std::array<PriceLevel, MAX_DEPTH_LEVELS> bids;
+        std::array<PriceLevel, MAX_DEPTH_LEVELS> asks;
         uint8_t bidsCount;
         uint8_t asksCount;
+        bool levelsTruncated; // A side had more than MAX_DEPTH_LEVELS levels (a delta can't be applied)
 
         // Metadata
-        uint64_t firstUpdateId;
-        uint64_t finalUpdateId;
+        bool isSnapshot;        // Partial book stream (has "lastUpdateId"): replaces levels instead of merging
+        uint64_t lastUpdateId;  // Snapshot only
+        uint64_t firstUpdateId; // Delta only (U)
+        uint64_t finalUpdateId; // Delta only (u)
         uint64_t eventTime;
         uint64_t dsTime;
         uint64_t wsTime;
 
-        DepthData() : symbolLen(0), bidsCount(0), asksCount(0),
-                      firstUpdateId(0), finalUpdateId(0),
-                      eventTime(0), dsTime(0), wsTime(0)
+        DepthData() { reset(); }
+
+        /**
+         * Reset every field the parser may leave unset, for reuse by the next message
+         * Level arrays are left as is: only the first bidsCount/asksCount entries are read
+         */
+        void reset()
+        {
+            symbol[0] = '\0';
+            symbolLen = 0;
+            bidsCount = 0;
+            asksCount = 0;
+            levelsTruncated = false;
+            isSnapshot = false;
+            lastUpdateId = 0;
+            firstUpdateId = 0;
+            finalUpdateId = 0;
+            eventTime = 0;
+            dsTime = 0;
+            wsTime = 0;
+        }
+    };
+
+    /**
+     * REST depth snapshot ({"lastUpdateId":...,"bids":[...],"asks":[...]})
+     * Holds every level of the response, used to (re)sync an order book
+     */
+    struct DepthSnapshotData
+    {
+        char symbol[16]; // Set by the caller (REST snapshots carry no symbol)
+        uint8_t symbolLen;
+
+        std::vector<PriceLevel> bids;
+        std::vector<PriceLevel> asks;
+        uint64_t lastUpdateId;
+
+        DepthSnapshotData() : symbolLen(0), lastUpdateId(0)
         {
             symbol[0] = '\0';
         }
@@ -59,13 +102,12 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
         char symbol[16];
         uint8_t symbolLen;
 
-        double price;
-        double quantity;
+        Decimal price;
+        Decimal quantity;
         uint64_t timestamp;
         bool isBuyerMaker;
 
-        TradeData() : symbolLen(0), price(0.0), quantity(0.0),
-                      timestamp(0), isBuyerMaker(false)
+        TradeData() : symbolLen(0), timestamp(0), isBuyerMaker(false)
         {
             symbol[0] = '\0';
         }
@@ -79,18 +121,16 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
         char symbol[16];
         uint8_t symbolLen;
 
-        double lastPrice;
-        double volume;
-        double high24h;
-        double low24h;
-        double open24h;
-        double change24h;
-        double changePercent24h;
+        Decimal lastPrice;
+        Decimal volume;
+        Decimal high24h;
+        Decimal low24h;
+        Decimal open24h;
+        Decimal change24h;
+        double changePercent24h; // Ratio, not a wire price: stays floating point
         uint64_t eventTime;
 
-        TickerData() : symbolLen(0), lastPrice(0.0), volume(0.0),
-                       high24h(0.0), low24h(0.0), open24h(0.0),
-                       change24h(0.0), changePercent24h(0.0), eventTime(0)
+        TickerData() : symbolLen(0), changePercent24h(0.0), eventTime(0)
         {
             symbol[0] = '\0';
         }
@@ -104,11 +144,11 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
         char symbol[16];
         uint8_t symbolLen;
 
-        double lastPrice;
-        double volume;
+        Decimal lastPrice;
+        Decimal volume;
         uint64_t eventTime;
 
-        MiniTickerData() : symbolLen(0), lastPrice(0.0), volume(0.0), eventTime(0)
+        MiniTickerData() : symbolLen(0), eventTime(0)
         {
             symbol[0] = '\0';
         }
@@ -125,16 +165,14 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
 
         uint64_t openTime;
         uint64_t closeTime;
-        double open;
-        double high;
-        double low;
-        double close;
-        double volume;
+        Decimal open;
+        Decimal high;
+        Decimal low;
+        Decimal close;
+        Decimal volume;
         uint64_t eventTime;
 
-        KlineData() : symbolLen(0), openTime(0), closeTime(0),
-                      open(0.0), high(0.0), low(0.0), close(0.0),
-                      volume(0.0), eventTime(0)
+        KlineData() : symbolLen(0), openTime(0), closeTime(0), eventTime(0)
         {
             symbol[0] = '\0';
         }
@@ -150,9 +188,9 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
 
         uint64_t orderId;
         uint64_t clientOrderId;
-        double price;
-        double quantity;
-        double executedQty;
+        Decimal price;
+        Decimal quantity;
+        Decimal executedQty;
         char status[16]; // "NEW", "FILLED", "CANCELED", etc.
         uint8_t statusLen;
         char side[8]; // "BUY", "SELL"
@@ -162,7 +200,6 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
         uint64_t eventTime;
 
         UserData() : symbolLen(0), orderId(0), clientOrderId(0),
-                     price(0.0), quantity(0.0), executedQty(0.0),
                      statusLen(0), sideLen(0), typeLen(0), eventTime(0)
         {
             symbol[0] = '\0';
@@ -184,6 +221,7 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
         MINI_TICKER = 3,
         KLINE = 4,
         USER_DATA = 5,
+        MINI_TICKER_ARRAY = 6, // !miniTicker@arr: all symbols in one frame
         UNKNOWN = 255
     };
 
@@ -0,0 +1,324 @@
+#pragma once
+
+#include "NumberFormatter.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * Fixed-point decimal for prices and quantities: mantissa / 10^scale
+     *
+     * Features:
+     * - 8 bytes, trivially copyable (safe in ring buffers and POD structs):
+     *   59-bit signed mantissa and 5-bit scale packed in one int64
+     * - parse() reads the exchange's decimal text exactly (no double round-trip);
+     *   digits beyond maxScale are rounded half away from zero, and the scale is
+     *   lowered automatically if the mantissa would overflow
+     * - Exact comparison and addition/subtraction across different scales
+     * - Formatting with integer to_chars only (no floating point)
+     */
+    class Decimal
+    {
+    public:
+        static constexpr int MAX_SCALE = 18;
+        static constexpr int DEFAULT_SCALE = 8;                          // Used when only a double is available
+        static constexpr int64_t MAX_MANTISSA = (int64_t(1) << 58) - 1; // ~2.9e17
+
+    private:
+        static constexpr int SCALE_BITS = 5;
+        static constexpr int64_t SCALE_MASK = (int64_t(1) << SCALE_BITS) - 1;
+
+        static constexpr int64_t POW10[] = {
+            1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL,
+            100000000LL, 1000000000LL, 10000000000LL, 100000000000LL, 1000000000000LL,
+            10000000000000LL, 100000000000000LL, 1000000000000000LL, 10000000000000000LL,
+            100000000000000000LL, 1000000000000000000LL};
+
+        int64_t bits_ = 0; // mantissa << SCALE_BITS | scale
+
+        /**
+         * Divide by 10^digits, rounding half away from zero
+         */
+        static int64_t roundDiv(int64_t value, int digits)
+        {
+            const int64_t divisor = POW10[digits];
+            const int64_t quotient = value / divisor;
+            const int64_t remainder = value % divisor;
+            if (2 * (remainder < 0 ? -remainder : remainder) >= divisor)
+            {
+                return quotient + (value < 0 ? -1 : 1);
+            }
+            return quotient;
+        }
+
+        /**
+         * mantissa * 10^digits, false on overflow of the mantissa range
+         */
+        static bool scaleUp(int64_t mantissa, int digits, int64_t &out)
+        {
+            if (__builtin_mul_overflow(mantissa, POW10[digits], &out))
+            {
+                return false;
+            }
+            return out <= MAX_MANTISSA && out >= -MAX_MANTISSA;
+        }
+
+        /**
+         * Build from an exact mantissa/scale, lowering scale (with rounding) until it fits
+         */
+        static Decimal normalized(int64_t mantissa, int scale)
+        {
+            while ((mantissa > MAX_MANTISSA || mantissa < -MAX_MANTISSA) && scale > 0)
+            {
+                mantissa = roundDiv(mantissa, 1);
+                --scale;
+            }
+            return fromRaw(mantissa, scale);
+        }
+
+    public:
+        constexpr Decimal() = default;
+
+        /**
+         * Build from mantissa and scale (mantissa must be within +-MAX_MANTISSA)
+         */
+        static constexpr Decimal fromRaw(int64_t mantissa, int scale)
+        {
+            Decimal result;
+            result.bits_ = static_cast<int64_t>(static_cast<uint64_t>(mantissa) << SCALE_BITS) | scale;
+            return result;
+        }
+
+        /**
+         * Nearest decimal with the given scale (for sources that only provide a double)
+         */
+        static Decimal fromDouble(double value, int scale = DEFAULT_SCALE)
+        {
+            if (!std::isfinite(value))
+            {
+                return Decimal();
+            }
+            scale = std::clamp(scale, 0, MAX_SCALE);
+            while (scale > 0 && std::fabs(value) * static_cast<double>(POW10[scale]) > static_cast<double>(MAX_MANTISSA))
+            {
+                --scale;
+            }
+            const double scaled = std::nearbyint(value * static_cast<double>(POW10[scale]));
+            if (std::fabs(scaled) > static_cast<double>(MAX_MANTISSA))
+            {
+                return fromRaw(scaled < 0 ? -MAX_MANTISSA : MAX_MANTISSA, 0);
+            }
+            return fromRaw(static_cast<int64_t>(scaled), scale);
+        }
+
+        /**
+         * Parse decimal text ("123", "-0.00012", "+5.") without allocation
+         * Keeps the text's own scale up to maxScale (extra digits are rounded)
+         * Returns false for empty/malformed text, exponents or an integer part that cannot fit
+         */
+        static bool parse(std::string_view text, Decimal &out, int maxScale = MAX_SCALE)
+        {
+            maxScale = std::clamp(maxScale, 0, MAX_SCALE);
+
+            size_t pos = 0;
+            bool negative = false;
+            if (pos < text.size() && (text[pos] == '-' || text[pos] == '+'))
+            {
+                negative = text[pos] == '-';
+                ++pos;
+            }
+
+            int64_t mantissa = 0;
+            int scale = 0;
+            bool anyDigit = false;
+
+            for (; pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; ++pos)
+            {
+                mantissa = mantissa * 10 + (text[pos] - '0');
+                if (mantissa > MAX_MANTISSA)
+                {
+                    return false;
+                }
+                anyDigit = true;
+            }
+
+            int roundDigit = 0; // First digit dropped from the fraction
+            if (pos < text.size() && text[pos] == '.')
+            {
+                ++pos;
+                bool dropping = false;
+                for (; pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; ++pos)
+                {
+                    anyDigit = true;
+                    const int digit = text[pos] - '0';
+                    if (!dropping && scale < maxScale && mantissa <= (MAX_MANTISSA - digit) / 10)
+                    {
+                        mantissa = mantissa * 10 + digit;
+                        ++scale;
+                    }
+                    else if (!dropping)
+                    {
+                        roundDigit = digit;
+                        dropping = true;
+                    }
+                }
+            }
+
+            if (!anyDigit || pos != text.size())
+            {
+                return false;
+            }
+
+            if (roundDigit >= 5)
+            {
+                ++mantissa;
+            }
+            out = normalized(negative ? -mantissa : mantissa, scale);
+            return true;
+        }
+
+        int64_t mantissa() const { return bits_ >> SCALE_BITS; }
+        int scale() const { return static_cast<int>(bits_ & SCALE_MASK); }
+        bool isZero() const { return mantissa() == 0; }
+        bool isNegative() const { return mantissa() < 0; }
+        bool isPositive() const { return mantissa() > 0; }
+
+        /**
+         * Nearest double (exact division for mantissas below 2^53)
+         */
+        double toDouble() const
+        {
+            return static_cast<double>(mantissa()) / static_cast<double>(POW10[scale()]);
+        }
+
+        /**
+         * Same value with another scale (rounded when reducing, scale capped when it would overflow)
+         */
+        Decimal rescaled(int newScale) const
+        {
+            newScale = std::clamp(newScale, 0, MAX_SCALE);
+            const int current = scale();
+            if (newScale < current)
+            {
+                return fromRaw(roundDiv(mantissa(), current - newScale), newScale);
+            }
+            int64_t scaled = 0;
+            while (newScale > current && !scaleUp(mantissa(), newScale - current, scaled))
+            {
+                --newScale;
+            }
+            return newScale > current ? fromRaw(scaled, newScale) : *this;
+        }
+
+        /**
+         * Exact three-way comparison (-1, 0, 1) across scales
+         */
+        static int compare(Decimal a, Decimal b)
+        {
+            int64_t left = a.mantissa();
+            int64_t right = b.mantissa();
+            const int diff = a.scale() - b.scale();
+            if (diff > 0 && __builtin_mul_overflow(right, POW10[diff], &right))
+            {
+                // |b| beyond int64 after aligning: b dominates
+                return b.mantissa() < 0 ? 1 : -1;
+            }
+            if (diff < 0 && __builtin_mul_overflow(left, POW10[-diff], &left))
+            {
+                return a.mantissa() < 0 ? -1 : 1;
+            }
+            return left < right ? -1 : (left > right ? 1 : 0);
+        }
+
+        friend bool operator==(Decimal a, Decimal b) { return compare(a, b) == 0; }
+        friend bool operator!=(Decimal a, Decimal b) { return compare(a, b) != 0; }
+        friend bool operator<(Decimal a, Decimal b) { return compare(a, b) < 0; }
+        friend bool operator>(Decimal a, Decimal b) { return compare(a, b) > 0; }
+        friend bool operator<=(Decimal a, Decimal b) { return compare(a, b) <= 0; }
+        friend bool operator>=(Decimal a, Decimal b) { return compare(a, b) >= 0; }
+
+        /**
+         * Exact sum/difference at the larger scale (scale lowered only if the result would overflow)
+         */
+        friend Decimal operator+(Decimal a, Decimal b)
+        {
+            const int scale = std::max(a.scale(), b.scale());
+            int64_t left = a.mantissa();
+            int64_t right = b.mantissa();
+            int64_t sum = 0;
+            if (!__builtin_mul_overflow(left, POW10[scale - a.scale()], &left) &&
+                !__builtin_mul_overflow(right, POW10[scale - b.scale()], &right) &&
+                !__builtin_add_overflow(left, right, &sum))
+            {
+                return normalized(sum, scale);
+            }
+            return fromDouble(a.toDouble() + b.toDouble(), scale);
+        }
+
+        friend Decimal operator-(Decimal a, Decimal b)
+        {
+            return a + fromRaw(-b.mantissa(), b.scale());
+        }
+
+        Decimal &operator+=(Decimal other) { return *this = *this + other; }
+        Decimal &operator-=(Decimal other) { return *this = *this - other; }
+
+        /**
+         * Write as decimal text into out (at least 24 chars)
+         * decimals: fixed number of decimals (rounded/padded) or NumberFormatter::SHORTEST
+         * (exact value without trailing zeros)
+         */
+        size_t write(char *out, int decimals = NumberFormatter::SHORTEST) const
+        {
+            int64_t value = mantissa();
+            int digits = scale();
+
+            if (decimals < 0)
+            {
+                while (digits > 0 && value % 10 == 0)
+                {
+                    value /= 10;
+                    --digits;
+                }
+            }
+            else if (decimals < digits)
+            {
+                value = roundDiv(value, digits - decimals);
+                digits = decimals;
+            }
+
+            const uint64_t magnitude = value < 0 ? static_cast<uint64_t>(-value) : static_cast<uint64_t>(value);
+            size_t length = NumberFormatter::writeScaled(out, magnitude, digits, value < 0);
+
+            // Pad to the requested number of decimals
+            if (decimals > digits)
+            {
+                const int target = std::min(decimals, MAX_SCALE);
+                if (digits == 0 && target > 0)
+                {
+                    out[length++] = '.';
+                }
+                for (int i = digits; i < target; ++i)
+                {
+                    out[length++] = '0';
+                }
+            }
+            return length;
+        }
+
+        std::string toString(int decimals = NumberFormatter::SHORTEST) const
+        {
+            char buffer[48];
+            return std::string(buffer, write(buffer, decimals));
+        }
+    };
+
+    static_assert(sizeof(Decimal) == sizeof(int64_t), "Decimal must stay 8 bytes");
+    static_assert(std::is_trivially_copyable_v<Decimal>, "Decimal must be trivially copyable");
+}
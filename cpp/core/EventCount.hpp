@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * Hint to the CPU that we are in a spin-wait loop
+     * (PAUSE on x86, YIELD on ARM) - keeps the spinning core cool and
+     * releases pipeline resources to the sibling hyper-thread
+     */
+    inline void cpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield" ::: "memory");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    /**
+     * EventCount - spin-then-park wakeup for consumer threads
+     *
+     * Features:
+     * - Consumer spins for a bounded time, then parks on a futex (std::atomic::wait)
+     * - Producer notify is a single fence + load while nobody is parked
+     * - No lost wakeups: consumer re-checks its condition after announcing itself
+     *
+     * Consumer protocol:
+     *   uint32_t key = ec.prepareWait();
+     *   if (conditionMet) { ec.cancelWait(); } else { ec.commitWait(key); }
+     *
+     * Producer protocol:
+     *   publish item (release store); ec.notifyOne();
+     */
+    class EventCount
+    {
+    private:
+        alignas(64) std::atomic<uint32_t> epoch_{0};
+        std::atomic<uint32_t> waiters_{0};
+
+        void notify(bool all)
+        {
+            // Pairs with the fence in prepareWait(): either we see the waiter,
+            // or the waiter sees the item we published before calling notify
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters_.load(std::memory_order_relaxed) == 0)
+            {
+                return;
+            }
+
+            epoch_.fetch_add(1, std::memory_order_release);
+            if (all)
+            {
+                epoch_.notify_all();
+            }
+            else
+            {
+                epoch_.notify_one();
+            }
+        }
+
+    public:
+        // Bounded spin before parking (keeps wake latency low under steady flow)
+        static constexpr std::chrono::microseconds DEFAULT_SPIN_TIME{50};
+
+        EventCount() = default;
+
+        // Non-copyable, non-movable
+        EventCount(const EventCount &) = delete;
+        EventCount &operator=(const EventCount &) = delete;
+        EventCount(EventCount &&) = delete;
+        EventCount &operator=(EventCount &&) = delete;
+
+        /**
+         * Announce intent to park, returns key for commitWait()
+         * Caller must re-check its condition after this call
+         */
+        uint32_t prepareWait()
+        {
+            waiters_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return epoch_.load(std::memory_order_acquire);
+        }
+
+        /**
+         * Condition became true after prepareWait() - don't park
+         */
+        void cancelWait()
+        {
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * Park until a producer notifies after prepareWait() returned key
+         */
+        void commitWait(uint32_t key)
+        {
+            epoch_.wait(key, std::memory_order_acquire);
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        /**
+         * Wake one parked consumer (no-op if nobody is parked)
+         */
+        void notifyOne() { notify(false); }
+
+        /**
+         * Wake all parked consumers (no-op if nobody is parked)
+         */
+        void notifyAll() { notify(true); }
+
+        /**
+         * Spin until ready() returns true or spinTime elapses
+         * Returns true if ready, false if the caller should park
+         */
+        template <typename Predicate>
+        static bool spinUntil(Predicate &&ready, std::chrono::microseconds spinTime = DEFAULT_SPIN_TIME)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + spinTime;
+            for (uint32_t i = 1;; ++i)
+            {
+                if (ready())
+                {
+                    return true;
+                }
+                cpuRelax();
+
+                // Only read the clock every 64 iterations
+                if ((i & 63) == 0 && std::chrono::steady_clock::now() >= deadline)
+                {
+                    return false;
+                }
+            }
+        }
+    };
+}
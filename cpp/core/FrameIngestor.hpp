@@ -0,0 +1,138 @@
+#pragma once
+
+#include "FrameRing.hpp"
+#include "EventCount.hpp"
+#include <atomic>
+#include <functional>
+#include <string_view>
+#include <thread>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * Frame Ingestor
+     * Moves message detection and parsing off the caller (JS) thread
+     *
+     * The caller only copies the raw frame into a FrameRing; the ingest worker
+     * pops frames in arrival order and hands them to the handler, which detects
+     * the message type and parses into the per-stream processors.
+     */
+    template <size_t RingCapacity>
+    class FrameIngestor
+    {
+    public:
+        using Handler = std::function<void(std::string_view)>;
+        using FrameRingType = FrameRing<RingCapacity>;
+
+    private:
+        FrameRingType frame_ring_;
+        std::atomic<bool> running_{false};
+        std::thread worker_thread_;
+        Handler handler_;
+        EventCount wakeup_;
+
+        bool hasWork() const
+        {
+            return !frame_ring_.empty() || !running_.load(std::memory_order_acquire);
+        }
+
+        void workerLoop()
+        {
+            std::string_view frame;
+            while (running_.load(std::memory_order_acquire))
+            {
+                if (frame_ring_.peek(frame))
+                {
+                    handler_(frame);
+                    frame_ring_.release();
+                    continue;
+                }
+
+                if (EventCount::spinUntil([this]
+                                          { return hasWork(); }))
+                {
+                    continue;
+                }
+
+                const uint32_t key = wakeup_.prepareWait();
+                if (hasWork())
+                {
+                    wakeup_.cancelWait();
+                    continue;
+                }
+                wakeup_.commitWait(key);
+            }
+        }
+
+    public:
+        FrameIngestor() = default;
+
+        ~FrameIngestor()
+        {
+            stop();
+        }
+
+        // Non-copyable, non-movable
+        FrameIngestor(const FrameIngestor &) = delete;
+        FrameIngestor &operator=(const FrameIngestor &) = delete;
+        FrameIngestor(FrameIngestor &&) = delete;
+        FrameIngestor &operator=(FrameIngestor &&) = delete;
+
+        /**
+         * Start ingest worker
+         */
+        void start(Handler handler)
+        {
+            if (running_.load(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            handler_ = std::move(handler);
+            running_.store(true, std::memory_order_release);
+            worker_thread_ = std::thread(&FrameIngestor::workerLoop, this);
+        }
+
+        /**
+         * Stop ingest worker (frames still queued are discarded)
+         */
+        void stop()
+        {
+            if (!running_.load(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            running_.store(false, std::memory_order_release);
+            wakeup_.notifyAll();
+            if (worker_thread_.joinable())
+            {
+                worker_thread_.join();
+            }
+        }
+
+        /**
+         * Copy raw frame into the ingest ring (one memcpy, no parsing)
+         * Returns false if the frame was dropped (ring full or frame too large)
+         */
+        bool push(std::string_view frame)
+        {
+            if (!frame_ring_.push(frame))
+            {
+                return false;
+            }
+            wakeup_.notifyOne();
+            return true;
+        }
+
+        /**
+         * Get ring statistics
+         */
+        size_t getPendingBytes() const { return frame_ring_.pendingBytes(); }
+        uint64_t getPushCount() const { return frame_ring_.getPushCount(); }
+        uint64_t getDropCount() const { return frame_ring_.getDropCount(); }
+    };
+
+    // 1MB of raw frames in flight between the JS thread and the ingest worker
+    using RawFrameIngestor = FrameIngestor<1u << 20>;
+}
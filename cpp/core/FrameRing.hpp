@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * Lock-free SPSC byte ring for raw WebSocket frames
+     *
+     * Features:
+     * - Variable-length records: [uint32 length][payload], 8-byte aligned
+     * - Records never straddle the end of the buffer (wrap marker instead),
+     *   so the consumer reads each frame as one contiguous string_view
+     * - READ_SLACK extra bytes after the buffer so SIMD readers may over-read
+     * - Drops the newest frame when full (producer never touches consumer index)
+     */
+    template <size_t Capacity>
+    class FrameRing
+    {
+        static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
+        static_assert(Capacity >= 1024, "Capacity must be at least 1KB");
+
+    public:
+        static constexpr size_t READ_SLACK = 64;
+        // Largest frame accepted (keeps at least two records in flight)
+        static constexpr size_t MAX_FRAME_SIZE = Capacity / 2 - 16;
+
+    private:
+        static constexpr size_t HEADER_SIZE = sizeof(uint32_t);
+        static constexpr size_t RECORD_ALIGN = 8;
+        static constexpr uint32_t WRAP_MARKER = 0xFFFFFFFFu;
+
+        // Byte offsets grow monotonically, masked on access
+        alignas(64) std::atomic<size_t> head_{0}; // Producer offset
+        alignas(64) std::atomic<size_t> tail_{0}; // Consumer offset
+        size_t pendingTail_{0};                   // Consumer-only: tail after current frame
+
+        alignas(64) std::atomic<uint64_t> pushCount_{0};
+        alignas(64) std::atomic<uint64_t> dropCount_{0};
+
+        std::unique_ptr<char[]> buffer_;
+
+        static constexpr size_t recordSize(size_t len)
+        {
+            return (HEADER_SIZE + len + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+        }
+
+        uint32_t readHeader(size_t offset) const
+        {
+            uint32_t len;
+            std::memcpy(&len, buffer_.get() + offset, HEADER_SIZE);
+            return len;
+        }
+
+        void writeHeader(size_t offset, uint32_t len)
+        {
+            std::memcpy(buffer_.get() + offset, &len, HEADER_SIZE);
+        }
+
+    public:
+        FrameRing() : buffer_(new char[Capacity + READ_SLACK]())
+        {
+        }
+
+        // Non-copyable, non-movable
+        FrameRing(const FrameRing &) = delete;
+        FrameRing &operator=(const FrameRing &) = delete;
+        FrameRing(FrameRing &&) = delete;
+        FrameRing &operator=(FrameRing &&) = delete;
+
+        /**
+         * Copy frame into ring (producer operation)
+         * Returns false if the frame is too large or the ring is full (frame dropped)
+         */
+        bool push(std::string_view frame)
+        {
+            if (frame.size() > MAX_FRAME_SIZE)
+            {
+                dropCount_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            const size_t currentHead = head_.load(std::memory_order_relaxed);
+            const size_t currentTail = tail_.load(std::memory_order_acquire);
+            const size_t size = recordSize(frame.size());
+
+            size_t offset = currentHead & (Capacity - 1);
+            const size_t contiguous = Capacity - offset;
+            const size_t needed = contiguous < size ? contiguous + size : size;
+
+            if (currentHead - currentTail + needed > Capacity)
+            {
+                dropCount_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            size_t nextHead = currentHead;
+            if (contiguous < size)
+            {
+                // Skip the tail end of the buffer so the record stays contiguous
+                writeHeader(offset, WRAP_MARKER);
+                nextHead += contiguous;
+                offset = 0;
+            }
+
+            writeHeader(offset, static_cast<uint32_t>(frame.size()));
+            std::memcpy(buffer_.get() + offset + HEADER_SIZE, frame.data(), frame.size());
+
+            // Release: payload visible before the consumer sees the new head
+            head_.store(nextHead + size, std::memory_order_release);
+            pushCount_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        /**
+         * Peek next frame without copying (consumer operation)
+         * The view stays valid until release() is called
+         */
+        bool peek(std::string_view &frame)
+        {
+            size_t currentTail = tail_.load(std::memory_order_relaxed);
+            const size_t currentHead = head_.load(std::memory_order_acquire);
+            if (currentTail == currentHead)
+            {
+                return false;
+            }
+
+            size_t offset = currentTail & (Capacity - 1);
+            uint32_t len = readHeader(offset);
+            if (len == WRAP_MARKER)
+            {
+                currentTail += Capacity - offset;
+                offset = 0;
+                len = readHeader(0);
+            }
+
+            frame = std::string_view(buffer_.get() + offset + HEADER_SIZE, len);
+            pendingTail_ = currentTail + recordSize(len);
+            return true;
+        }
+
+        /**
+         * Release the frame returned by the last successful peek()
+         */
+        void release()
+        {
+            tail_.store(pendingTail_, std::memory_order_release);
+        }
+
+        /**
+         * Check if ring is empty (non-blocking)
+         */
+        bool empty() const
+        {
+            return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+        }
+
+        /**
+         * Bytes currently queued (approximate under concurrent access)
+         */
+        size_t pendingBytes() const
+        {
+            return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+        }
+
+        static constexpr size_t capacity() { return Capacity; }
+
+        /**
+         * Get statistics (for debugging)
+         */
+        uint64_t getPushCount() const { return pushCount_.load(std::memory_order_relaxed); }
+        uint64_t getDropCount() const { return dropCount_.load(std::memory_order_relaxed); }
+    };
+}
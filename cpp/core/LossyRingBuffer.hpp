@@ -0,0 +1,347 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <algorithm>
+#include <span>
+#include <type_traits>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * Lock-free lossy SPSC Ring Buffer with sequence-stamped slots
+     *
+     * Features:
+     * - Drop oldest when full: the producer never waits for or touches the consumer,
+     *   it simply overwrites the oldest slot
+     * - Each slot carries a sequence stamp (seqlock): the consumer detects a slot
+     *   that was overwritten before or while it was read, skips it and counts it
+     *   as lost - no torn items are ever returned
+     * - Slot payload is stored as relaxed atomic words, so a concurrent overwrite
+     *   is not a data race under the C++ memory model
+     * - claim() hands out a producer-private staging item (not the slot: slot words
+     *   may be read concurrently); commit() publishes it with one word-wise copy,
+     *   the copy the seqlock needs anyway. push() copies straight from the caller's item
+     * - Consumer-side "messages lost" counter
+     * - Each side caches the other's position and only re-reads it when the
+     *   ring looks full (producer) or empty (consumer)
+     * - Statistics are plain owner-thread counters on the owner's cache line
+     *
+     * T must be trivially copyable (POD structs from DataStructs.hpp)
+     */
+    template <typename T, size_t Size>
+    class LossyRingBuffer
+    {
+        static_assert((Size & (Size - 1)) == 0, "Size must be power of 2");
+        static_assert(Size > 0, "Size must be greater than 0");
+        static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+    private:
+        static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+        static constexpr size_t TAIL_BYTES = sizeof(T) - (WORD_COUNT - 1) * sizeof(uint64_t); // Bytes in the last word
+
+        struct alignas(64) Slot
+        {
+            // 2*pos+1 while writing position pos, 2*pos+2 once complete (0 = never written)
+            std::atomic<uint64_t> seq{0};
+            std::atomic<uint64_t> words[WORD_COUNT];
+        };
+
+        // Producer cache line
+        alignas(64) std::atomic<size_t> head_{0}; // Next position to write (monotonic)
+        size_t cachedReadPos_{0};                 // Producer-only copy of readPos_, refreshed when ring looks full
+        std::atomic<uint64_t> pushCount_{0};      // Producer-owned statistics
+        alignas(8) unsigned char staging_[WORD_COUNT * sizeof(uint64_t)];
+
+        // Consumer cache line
+        alignas(64) std::atomic<size_t> readPos_{0}; // Next position to read (monotonic)
+        size_t cachedHead_{0};                       // Consumer-only copy of head_, refreshed when ring looks empty
+        std::atomic<uint64_t> popCount_{0};          // Consumer-owned statistics
+        std::atomic<uint64_t> lostCount_{0};         // Items overwritten before the consumer got them
+
+        Slot slots_[Size];
+
+        // Statistics are written only by their owning thread: plain load+store, no RMW
+        static void bumpCounter(std::atomic<uint64_t> &counter, uint64_t n)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        /**
+         * Producer: number of unread items that pos would overwrite
+         * Only re-reads the consumer position when the cached one says the ring is full
+         */
+        size_t overwrittenBy(size_t pos)
+        {
+            if (pos - cachedReadPos_ < Size)
+            {
+                return 0;
+            }
+            cachedReadPos_ = readPos_.load(std::memory_order_relaxed);
+            return pos - cachedReadPos_ >= Size ? pos - cachedReadPos_ - Size + 1 : 0;
+        }
+
+        T *stagingItem()
+        {
+            return std::launder(reinterpret_cast<T *>(staging_));
+        }
+
+        /**
+         * Stamp and copy item into the slot for position pos (producer)
+         */
+        void writeSlot(size_t pos, const T &item)
+        {
+            const unsigned char *src = reinterpret_cast<const unsigned char *>(&item);
+            Slot &slot = slots_[pos & (Size - 1)];
+            slot.seq.store(2 * static_cast<uint64_t>(pos) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            for (size_t i = 0; i + 1 < WORD_COUNT; ++i)
+            {
+                uint64_t word;
+                std::memcpy(&word, src + i * sizeof(uint64_t), sizeof(uint64_t));
+                slot.words[i].store(word, std::memory_order_relaxed);
+            }
+            // Last word: only the bytes that belong to item (never read past its end)
+            uint64_t tail = 0;
+            std::memcpy(&tail, src + (WORD_COUNT - 1) * sizeof(uint64_t), TAIL_BYTES);
+            slot.words[WORD_COUNT - 1].store(tail, std::memory_order_relaxed);
+
+            slot.seq.store(2 * static_cast<uint64_t>(pos) + 2, std::memory_order_release);
+        }
+
+        /**
+         * Copy the slot for position pos into item (consumer)
+         * Returns false if the slot was overwritten before or during the copy
+         */
+        bool readSlot(size_t pos, T &item) const
+        {
+            const Slot &slot = slots_[pos & (Size - 1)];
+            const uint64_t expected = 2 * static_cast<uint64_t>(pos) + 2;
+
+            if (slot.seq.load(std::memory_order_acquire) != expected)
+            {
+                return false;
+            }
+
+            alignas(8) unsigned char buffer[WORD_COUNT * sizeof(uint64_t)];
+            for (size_t i = 0; i < WORD_COUNT; ++i)
+            {
+                const uint64_t word = slot.words[i].load(std::memory_order_relaxed);
+                std::memcpy(buffer + i * sizeof(uint64_t), &word, sizeof(uint64_t));
+            }
+
+            // Re-check stamp: a producer lap during the copy means the copy may be torn
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != expected)
+            {
+                return false;
+            }
+
+            std::memcpy(&item, buffer, sizeof(T));
+            return true;
+        }
+
+        /**
+         * Read the oldest still-valid item at or after pos (consumer)
+         * Advances pos past the returned item and past any lost items
+         */
+        bool readNext(size_t &pos, size_t currentHead, T &item)
+        {
+            while (pos < currentHead)
+            {
+                // Lapped: everything older than the last Size positions is gone
+                if (currentHead - pos > Size)
+                {
+                    bumpCounter(lostCount_, currentHead - pos - Size);
+                    pos = currentHead - Size;
+                }
+
+                if (readSlot(pos, item))
+                {
+                    ++pos;
+                    return true;
+                }
+
+                // Overwritten while we were reading it: skip
+                bumpCounter(lostCount_, 1);
+                ++pos;
+                currentHead = cachedHead_ = head_.load(std::memory_order_acquire);
+            }
+            return false;
+        }
+
+    public:
+        LossyRingBuffer()
+        {
+            new (staging_) T();
+            for (auto &slot : slots_)
+            {
+                for (auto &word : slot.words)
+                {
+                    word.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Non-copyable, non-movable
+        LossyRingBuffer(const LossyRingBuffer &) = delete;
+        LossyRingBuffer &operator=(const LossyRingBuffer &) = delete;
+        LossyRingBuffer(LossyRingBuffer &&) = delete;
+        LossyRingBuffer &operator=(LossyRingBuffer &&) = delete;
+
+        /**
+         * Get the producer-private staging item to build the next item in (producer operation)
+         * Nothing is visible to the consumer until commit() copies it into a slot;
+         * if the producer abandons it (no commit), the next claim() reuses it.
+         */
+        T *claim()
+        {
+            return stagingItem();
+        }
+
+        /**
+         * Publish the item built in claim() (producer operation)
+         * Overwrites oldest item if buffer is full
+         * Returns true if an unread item was overwritten
+         */
+        bool commit()
+        {
+            return push(*stagingItem());
+        }
+
+        /**
+         * Push item to ring buffer (producer operation)
+         * Overwrites oldest item if buffer is full
+         * Returns true if an unread item was overwritten
+         */
+        bool push(const T &item)
+        {
+            const size_t pos = head_.load(std::memory_order_relaxed);
+            writeSlot(pos, item);
+            head_.store(pos + 1, std::memory_order_release);
+            bumpCounter(pushCount_, 1);
+
+            return overwrittenBy(pos) > 0;
+        }
+
+        /**
+         * Push many items with a single head publish (producer operation)
+         * Returns number of unread items overwritten (approximate)
+         */
+        size_t push_bulk(std::span<const T> items)
+        {
+            if (items.empty())
+            {
+                return 0;
+            }
+
+            const size_t firstPos = head_.load(std::memory_order_relaxed);
+            size_t pos = firstPos;
+            for (const T &item : items)
+            {
+                writeSlot(pos++, item);
+            }
+            head_.store(pos, std::memory_order_release);
+            bumpCounter(pushCount_, items.size());
+
+            return std::min(overwrittenBy(pos - 1), items.size());
+        }
+
+        /**
+         * Pop oldest still-valid item (consumer operation)
+         * Returns true if successful, false if buffer is empty
+         */
+        bool pop(T &item)
+        {
+            size_t pos = readPos_.load(std::memory_order_relaxed);
+            if (pos >= cachedHead_)
+            {
+                // Looks empty: refresh producer position
+                cachedHead_ = head_.load(std::memory_order_acquire);
+            }
+
+            const bool found = readNext(pos, cachedHead_, item);
+            readPos_.store(pos, std::memory_order_release);
+            if (found)
+            {
+                bumpCounter(popCount_, 1);
+            }
+            return found;
+        }
+
+        /**
+         * Pop up to out.size() items (consumer operation)
+         * Returns number of items written to the front of out
+         */
+        size_t pop_bulk(std::span<T> out)
+        {
+            size_t pos = readPos_.load(std::memory_order_relaxed);
+            if (cachedHead_ - pos < out.size())
+            {
+                // Fewer than requested known to be available: refresh producer position
+                cachedHead_ = head_.load(std::memory_order_acquire);
+            }
+
+            size_t count = 0;
+            while (count < out.size() && readNext(pos, cachedHead_, out[count]))
+            {
+                ++count;
+            }
+
+            readPos_.store(pos, std::memory_order_release);
+            if (count > 0)
+            {
+                bumpCounter(popCount_, count);
+            }
+            return count;
+        }
+
+        /**
+         * Check if buffer is empty (non-blocking)
+         */
+        bool empty() const
+        {
+            return readPos_.load(std::memory_order_acquire) >= head_.load(std::memory_order_acquire);
+        }
+
+        /**
+         * Get current size (approximate, may be slightly inaccurate due to concurrent access)
+         */
+        size_t size() const
+        {
+            const size_t currentRead = readPos_.load(std::memory_order_acquire);
+            const size_t currentHead = head_.load(std::memory_order_acquire);
+            if (currentHead <= currentRead)
+            {
+                return 0;
+            }
+            return currentHead - currentRead > Size ? Size : currentHead - currentRead;
+        }
+
+        /**
+         * Get capacity (every slot is usable, no reserved slot)
+         */
+        static constexpr size_t capacity() { return Size; }
+
+        /**
+         * Get statistics (for debugging)
+         */
+        uint64_t getPushCount() const { return pushCount_.load(std::memory_order_relaxed); }
+        uint64_t getPopCount() const { return popCount_.load(std::memory_order_relaxed); }
+        uint64_t getLostCount() const { return lostCount_.load(std::memory_order_relaxed); }
+
+        /**
+         * Reset statistics (only while producer and consumer are idle)
+         */
+        void resetStats()
+        {
+            pushCount_.store(0, std::memory_order_relaxed);
+            popCount_.store(0, std::memory_order_relaxed);
+            lostCount_.store(0, std::memory_order_relaxed);
+        }
+    };
+}
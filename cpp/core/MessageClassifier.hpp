@@ -0,0 +1,205 @@
+#pragma once
+
+#include "DataStructs.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * Message type detection from the stream name or event type
+     *
+     * Features:
+     * - One memchr pass over the key separators of the first SCAN_LIMIT bytes finds the
+     *   "stream" value and/or the first "e" value; never one scan per candidate type
+     * - Stream token ("btcusdt@depth20@100ms" -> "depth", "!miniTicker@arr" -> "!miniTicker")
+     *   and event type share one compile-time perfect hash table
+     * - Covers every stream the SDK handles, including aggTrade, !miniTicker@arr
+     *   and user-data executionReport events
+     */
+    class MessageClassifier
+    {
+    private:
+        struct Entry
+        {
+            std::string_view key;
+            MessageType type;
+        };
+
+        // Stream tokens (after '@', trailing digits/options removed) and "e" values
+        static constexpr Entry ENTRIES[] = {
+            {"depth", MessageType::DEPTH},
+            {"depthUpdate", MessageType::DEPTH},
+            {"trade", MessageType::TRADE},
+            {"aggTrade", MessageType::TRADE},
+            {"ticker", MessageType::TICKER},
+            {"24hrTicker", MessageType::TICKER},
+            {"miniTicker", MessageType::MINI_TICKER},
+            {"24hrMiniTicker", MessageType::MINI_TICKER},
+            {"!miniTicker", MessageType::MINI_TICKER_ARRAY},
+            {"kline", MessageType::KLINE},
+            {"executionReport", MessageType::USER_DATA},
+        };
+
+        static constexpr uint32_t TABLE_BITS = 5;
+        static constexpr size_t TABLE_SIZE = size_t{1} << TABLE_BITS;
+        static constexpr uint8_t EMPTY = 0xFF;
+        static constexpr size_t SCAN_LIMIT = 128; // Frame prefix holding "stream" and the first "e"
+
+        static constexpr size_t hash(std::string_view key, uint32_t seed)
+        {
+            // Length and three bytes tell every key apart; seed spreads them (multiplicative hash)
+            const size_t length = key.size();
+            const uint32_t mixed = ((static_cast<uint32_t>(length) * 131 +
+                                     static_cast<unsigned char>(key[0])) * 131 +
+                                    static_cast<unsigned char>(key[length / 2])) * 131 +
+                                   static_cast<unsigned char>(key[length - 1]);
+            return (mixed * seed) >> (32 - TABLE_BITS);
+        }
+
+        struct Table
+        {
+            uint32_t seed = 0;
+            std::array<uint8_t, TABLE_SIZE> slots{};
+        };
+
+        /**
+         * First seed that maps every key to its own slot (evaluated at compile time)
+         */
+        static constexpr Table buildTable()
+        {
+            for (uint32_t seed = 0x9E3779B1u; seed != 0x9E3779B1u + 100000; seed += 2)
+            {
+                Table table;
+                table.seed = seed;
+                table.slots.fill(EMPTY);
+                bool collision = false;
+                for (size_t i = 0; i < std::size(ENTRIES) && !collision; ++i)
+                {
+                    uint8_t &slot = table.slots[hash(ENTRIES[i].key, seed)];
+                    collision = slot != EMPTY;
+                    slot = static_cast<uint8_t>(i);
+                }
+                if (!collision)
+                {
+                    return table;
+                }
+            }
+            return Table{};
+        }
+
+        static const Table &table()
+        {
+            // Built at compile time (in a member function body, where the class is complete)
+            static constexpr Table TABLE = buildTable();
+            static_assert(TABLE.seed != 0, "No perfect hash seed found for MessageClassifier::ENTRIES");
+            return TABLE;
+        }
+
+        /**
+         * Quoted value starting at start (up to the closing quote), empty if unterminated
+         */
+        static std::string_view valueAt(std::string_view json, size_t start)
+        {
+            const void *quote = std::memchr(json.data() + start, '"', json.size() - start);
+            if (quote == nullptr)
+            {
+                return std::string_view();
+            }
+            return json.substr(start, static_cast<size_t>(static_cast<const char *>(quote) - json.data()) - start);
+        }
+
+        /**
+         * True if json[colon] is preceded by the quoted key (e.g. "\"e\"")
+         */
+        static bool keyBefore(std::string_view json, size_t colon, std::string_view quotedKey)
+        {
+            return colon >= quotedKey.size() &&
+                   std::memcmp(json.data() + colon - quotedKey.size(), quotedKey.data(), quotedKey.size()) == 0;
+        }
+
+        /**
+         * Type token of a stream name: "btcusdt@kline_1m" -> "kline", "!miniTicker@arr" -> "!miniTicker"
+         */
+        static std::string_view streamToken(std::string_view stream)
+        {
+            const size_t atPos = stream.find('@');
+            if (atPos == std::string_view::npos)
+            {
+                return std::string_view(); // Listen key (user data): no type in the name
+            }
+            if (stream[0] == '!')
+            {
+                return stream.substr(0, atPos); // All-market stream
+            }
+
+            // Letters only: "depth20@100ms" -> "depth", "kline_1m" -> "kline"
+            const char *begin = stream.data() + atPos + 1;
+            const char *end = begin;
+            const char *last = stream.data() + stream.size();
+            while (end < last && ((*end | 0x20) >= 'a' && (*end | 0x20) <= 'z'))
+            {
+                ++end;
+            }
+            return std::string_view(begin, static_cast<size_t>(end - begin));
+        }
+
+    public:
+        /**
+         * Type for a stream token or event type (UNKNOWN if not handled by the SDK)
+         */
+        static MessageType lookup(std::string_view key)
+        {
+            if (key.empty())
+            {
+                return MessageType::UNKNOWN;
+            }
+            const Table &lookupTable = table();
+            const uint8_t index = lookupTable.slots[hash(key, lookupTable.seed)];
+            if (index == EMPTY || ENTRIES[index].key != key)
+            {
+                return MessageType::UNKNOWN;
+            }
+            return ENTRIES[index].type;
+        }
+
+        static MessageType classify(std::string_view json)
+        {
+            // One pass over the key separators of the frame prefix: "stream" comes first in
+            // combined-stream frames, "e" first in event objects; a large payload is never scanned
+            const std::string_view head = json.substr(0, SCAN_LIMIT);
+            const char *colon = head.data();
+            const char *end = head.data() + head.size();
+            while ((colon = static_cast<const char *>(std::memchr(colon, ':', static_cast<size_t>(end - colon)))) != nullptr)
+            {
+                const size_t pos = static_cast<size_t>(colon - head.data());
+                ++colon;
+                if (colon == end || *colon != '"')
+                {
+                    continue; // Not a string value
+                }
+
+                if (keyBefore(head, pos, "\"stream\""))
+                {
+                    // Combined stream: {"stream":"btcusdt@depth","data":{...}}
+                    const std::string_view stream = valueAt(head, pos + 2);
+                    const MessageType type = lookup(streamToken(stream));
+                    if (type != MessageType::UNKNOWN || (!stream.empty() && stream[0] == '!'))
+                    {
+                        return type; // Unhandled all-market streams ("!ticker@arr") carry arrays of other events
+                    }
+                    // Listen key (user data) or unknown stream: the event type decides
+                }
+                else if (keyBefore(head, pos, "\"e\""))
+                {
+                    // Direct or user-data event: {"e":"executionReport",...}
+                    return lookup(valueAt(head, pos + 2));
+                }
+            }
+            return MessageType::UNKNOWN;
+        }
+    };
+}
@@ -0,0 +1,674 @@
+#pragma once
+
+#include "DataStructs.hpp"
+#include "Decimal.hpp"
+#include "PaddedArena.hpp"
+#include "../fast_float.h"
+#include <simdjson.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * Allocation-free, exception-free extraction of single JSON values
+     */
+    class JsonExtract
+    {
+    public:
+        /**
+         * Copy string to fixed-size buffer (for symbol, status, etc.)
+         */
+        static void copyToFixedBuffer(std::string_view src, char *dst, size_t maxLen, uint8_t &outLen)
+        {
+            size_t len = std::min(src.length(), maxLen - 1);
+            std::memcpy(dst, src.data(), len);
+            dst[len] = '\0';
+            outLen = static_cast<uint8_t>(len);
+        }
+
+        /**
+         * Parse the whole text as a double (no allocation, no exceptions, locale-free)
+         */
+        static bool parseDoubleText(std::string_view text, double &out)
+        {
+            if (text.empty())
+            {
+                return false;
+            }
+            const char *end = text.data() + text.size();
+            auto result = fast_float::from_chars(text.data(), end, out);
+            return result.ec == std::errc{} && result.ptr == end;
+        }
+
+        /**
+         * Parse the whole text as an unsigned integer (no allocation, no exceptions)
+         */
+        static bool parseUint64Text(std::string_view text, uint64_t &out)
+        {
+            if (text.empty())
+            {
+                return false;
+            }
+            const char *end = text.data() + text.size();
+            auto result = fast_float::from_chars(text.data(), end, out);
+            return result.ec == std::errc{} && result.ptr == end;
+        }
+
+        /**
+         * Raw text of a bare JSON number (simdjson may include trailing whitespace)
+         */
+        static std::string_view numberToken(simdjson::ondemand::value &val)
+        {
+            std::string_view token = val.raw_json_token();
+            while (!token.empty() && (token.back() == ' ' || token.back() == '\t' || token.back() == '\n' || token.back() == '\r'))
+            {
+                token.remove_suffix(1);
+            }
+            return token;
+        }
+
+        /**
+         * Extract double from JSON value (bare number or quoted string)
+         */
+        static double doubleValue(simdjson::ondemand::value &val, double defaultValue = 0.0)
+        {
+            double value = defaultValue;
+            if (val.get_double().get(value) == simdjson::SUCCESS)
+            {
+                return value;
+            }
+            std::string_view text;
+            if (val.get_string().get(text) == simdjson::SUCCESS && parseDoubleText(text, value))
+            {
+                return value;
+            }
+            return defaultValue;
+        }
+
+        /**
+         * Extract exact Decimal from JSON value (quoted string or bare number)
+         * The number's own text is parsed, so no precision is lost through double
+         */
+        static Decimal decimal(simdjson::ondemand::value &val, int maxScale = Decimal::MAX_SCALE)
+        {
+            Decimal result;
+            std::string_view text;
+            if (val.get_string().get(text) == simdjson::SUCCESS)
+            {
+                Decimal::parse(text, result, maxScale);
+                return result;
+            }
+
+            // Bare JSON number: parse its raw token text
+            const std::string_view token = numberToken(val);
+            if (Decimal::parse(token, result, maxScale))
+            {
+                return result;
+            }
+
+            // Exponent notation or out of range: nearest decimal
+            double value = 0.0;
+            if (parseDoubleText(token, value))
+            {
+                return Decimal::fromDouble(value, std::min(maxScale, Decimal::DEFAULT_SCALE));
+            }
+            return result;
+        }
+
+        /**
+         * Extract uint64 from JSON value (ids and timestamps are sometimes quoted)
+         */
+        static uint64_t uint64(simdjson::ondemand::value &val, uint64_t defaultValue = 0)
+        {
+            uint64_t value = defaultValue;
+            if (val.get_uint64().get(value) == simdjson::SUCCESS)
+            {
+                return value;
+            }
+            std::string_view text;
+            if (val.get_string().get(text) == simdjson::SUCCESS && parseUint64Text(text, value))
+            {
+                return value;
+            }
+            return defaultValue;
+        }
+
+        /**
+         * Extract bool from JSON value
+         */
+        static bool boolean(simdjson::ondemand::value &val, bool defaultValue = false)
+        {
+            bool value = defaultValue;
+            if (val.get_bool().get(value) == simdjson::SUCCESS)
+            {
+                return value;
+            }
+            return defaultValue;
+        }
+    };
+
+    /**
+     * Compile-time message schemas and the single-pass walker generated from them
+     *
+     * A schema is a struct with:
+     * - using Target = <POD from DataStructs.hpp>
+     * - static constexpr bool SYMBOL_FROM_STREAM: take the symbol from "stream" ("btcusdt@trade")
+     * - static constexpr schema::Field<Target> FIELDS[]: one entry per JSON key
+     *
+     * Features:
+     * - Both envelopes handled by one walk: {"stream":..,"data":{..}} and direct objects
+     * - Every object is walked once, in document order; keys are matched starting after
+     *   the previous match, so messages in the exchange's usual key order match immediately
+     * - Aliases: a fallbackFor() field shares its primary's slot and is only used
+     *   when the primary key is absent ("t" for "T"), regardless of document order
+     * - Required fields are checked after the walk
+     * - Decimals are stored at wire precision; display precision is applied only when formatting
+     */
+    namespace schema
+    {
+        /**
+         * Per-message walk bookkeeping
+         */
+        struct WalkState
+        {
+            static constexpr size_t MAX_FIELDS = 32;
+            static constexpr uint8_t UNSET = 0xFF;
+
+            std::array<uint8_t, MAX_FIELDS> filledBy; // Per slot: index of the field that wrote it
+            size_t cursor = 0;                        // Field index to try first for the next key
+            bool symbolFromStream = false;
+
+            WalkState() { filledBy.fill(UNSET); }
+        };
+
+        /**
+         * One JSON key of a schema
+         */
+        template <typename T>
+        struct Field
+        {
+            using Reader = bool (*)(simdjson::ondemand::value &, T &, WalkState &);
+
+            std::string_view key;
+            Reader read = nullptr;
+            bool required = false;
+            bool isSymbol = false; // Skipped when the symbol came from "stream"
+            std::string_view primary; // Non-empty: fallback for the field with this key
+
+            /**
+             * Same target as the field keyed primaryKey, read only if that key is absent
+             */
+            constexpr Field fallbackFor(std::string_view primaryKey) const
+            {
+                Field field = *this;
+                field.primary = primaryKey;
+                return field;
+            }
+        };
+
+        template <typename M>
+        struct MemberOf;
+
+        template <typename C, typename V>
+        struct MemberOf<V C::*>
+        {
+            using Class = C;
+            using Type = V;
+        };
+
+        template <auto Member>
+        using ClassOf = typename MemberOf<decltype(Member)>::Class;
+
+        // ---- Readers (one instantiation per target member) ----
+
+        template <auto Member>
+        bool readDecimal(simdjson::ondemand::value &val, ClassOf<Member> &out, WalkState &)
+        {
+            out.*Member = JsonExtract::decimal(val);
+            return true;
+        }
+
+        template <auto Member>
+        bool readUint64(simdjson::ondemand::value &val, ClassOf<Member> &out, WalkState &)
+        {
+            out.*Member = JsonExtract::uint64(val);
+            return true;
+        }
+
+        template <auto Member, auto Flag>
+        bool readFlaggedUint64(simdjson::ondemand::value &val, ClassOf<Member> &out, WalkState &)
+        {
+            out.*Member = JsonExtract::uint64(val);
+            out.*Flag = true;
+            return true;
+        }
+
+        template <auto Member>
+        bool readBool(simdjson::ondemand::value &val, ClassOf<Member> &out, WalkState &)
+        {
+            out.*Member = JsonExtract::boolean(val);
+            return true;
+        }
+
+        template <auto Text, auto Length>
+        bool readText(simdjson::ondemand::value &val, ClassOf<Text> &out, WalkState &)
+        {
+            std::string_view text;
+            if (val.get_string().get(text) != simdjson::SUCCESS)
+            {
+                return false;
+            }
+            JsonExtract::copyToFixedBuffer(text, out.*Text, sizeof(out.*Text), out.*Length);
+            return true;
+        }
+
+        /**
+         * One [price, quantity] pair (false if it isn't one)
+         */
+        inline bool readLevel(simdjson::simdjson_result<simdjson::ondemand::value> &levelResult, PriceLevel &out)
+        {
+            simdjson::ondemand::array level;
+            if (levelResult.get_array().get(level) != simdjson::SUCCESS)
+            {
+                return false;
+            }
+            size_t idx = 0;
+            for (auto itemResult : level)
+            {
+                simdjson::ondemand::value item;
+                if (itemResult.get(item) != simdjson::SUCCESS)
+                {
+                    return false;
+                }
+                if (idx == 0)
+                {
+                    out.price = JsonExtract::decimal(item);
+                }
+                else
+                {
+                    out.quantity = JsonExtract::decimal(item);
+                    return true;
+                }
+                ++idx;
+            }
+            return false;
+        }
+
+        /**
+         * [[price, quantity], ...] into a fixed PriceLevel array
+         * Levels past its capacity are not stored; Truncated is set instead
+         */
+        template <auto Levels, auto Count, auto Truncated>
+        bool readLevels(simdjson::ondemand::value &val, ClassOf<Levels> &out, WalkState &)
+        {
+            simdjson::ondemand::array levels;
+            if (val.get_array().get(levels) != simdjson::SUCCESS)
+            {
+                return false;
+            }
+
+            auto &target = out.*Levels;
+            size_t count = 0;
+            for (auto levelResult : levels)
+            {
+                if (count >= target.size())
+                {
+                    out.*Truncated = true;
+                    break;
+                }
+                if (readLevel(levelResult, target[count]))
+                {
+                    ++count;
+                }
+            }
+            out.*Count = static_cast<typename MemberOf<decltype(Count)>::Type>(count);
+            return true;
+        }
+
+        /**
+         * [[price, quantity], ...] into a std::vector<PriceLevel> (all levels, e.g. REST snapshots)
+         */
+        template <auto Levels>
+        bool readLevelList(simdjson::ondemand::value &val, ClassOf<Levels> &out, WalkState &)
+        {
+            simdjson::ondemand::array levels;
+            if (val.get_array().get(levels) != simdjson::SUCCESS)
+            {
+                return false;
+            }
+
+            auto &target = out.*Levels;
+            target.clear();
+            PriceLevel level;
+            for (auto levelResult : levels)
+            {
+                if (readLevel(levelResult, level))
+                {
+                    target.push_back(level);
+                }
+            }
+            return true;
+        }
+
+        template <typename Schema>
+        bool readObject(simdjson::ondemand::value &val, typename Schema::Target &out, WalkState &state);
+
+        // ---- Field factories (used in constexpr FIELDS tables) ----
+
+        template <auto Member>
+        constexpr Field<ClassOf<Member>> price(std::string_view key, bool required = false)
+        {
+            return {key, &readDecimal<Member>, required, false, {}};
+        }
+
+        template <auto Member>
+        constexpr Field<ClassOf<Member>> quantity(std::string_view key, bool required = false)
+        {
+            return {key, &readDecimal<Member>, required, false, {}};
+        }
+
+        template <auto Member>
+        constexpr Field<ClassOf<Member>> uint64(std::string_view key, bool required = false)
+        {
+            return {key, &readUint64<Member>, required, false, {}};
+        }
+
+        /**
+         * uint64 whose presence also sets Flag (e.g. "lastUpdateId" marks a partial book)
+         */
+        template <auto Member, auto Flag>
+        constexpr Field<ClassOf<Member>> flaggedUint64(std::string_view key)
+        {
+            return {key, &readFlaggedUint64<Member, Flag>, false, false, {}};
+        }
+
+        template <auto Member>
+        constexpr Field<ClassOf<Member>> boolean(std::string_view key)
+        {
+            return {key, &readBool<Member>, false, false, {}};
+        }
+
+        template <auto Text, auto Length>
+        constexpr Field<ClassOf<Text>> text(std::string_view key, bool required = false)
+        {
+            return {key, &readText<Text, Length>, required, false, {}};
+        }
+
+        template <auto Text, auto Length>
+        constexpr Field<ClassOf<Text>> symbol(std::string_view key)
+        {
+            return {key, &readText<Text, Length>, false, true, {}};
+        }
+
+        template <auto Levels, auto Count, auto Truncated>
+        constexpr Field<ClassOf<Levels>> levels(std::string_view key)
+        {
+            return {key, &readLevels<Levels, Count, Truncated>, false, false, {}};
+        }
+
+        template <auto Levels>
+        constexpr Field<ClassOf<Levels>> levelList(std::string_view key)
+        {
+            return {key, &readLevelList<Levels>, false, false, {}};
+        }
+
+        /**
+         * Nested object walked with the same schema (e.g. kline "k")
+         */
+        template <typename Schema, typename T>
+        constexpr Field<T> nested(std::string_view key)
+        {
+            return {key, &readObject<Schema>, false, false, {}};
+        }
+
+        // ---- Walker ----
+
+        template <typename Schema>
+        struct SchemaInfo
+        {
+            static constexpr size_t COUNT = std::size(Schema::FIELDS);
+            static_assert(COUNT <= WalkState::MAX_FIELDS, "Schema has too many fields");
+
+            // Fallbacks share their primary field's slot
+            static constexpr std::array<uint8_t, COUNT> SLOTS = []
+            {
+                std::array<uint8_t, COUNT> slots{};
+                for (size_t i = 0; i < COUNT; ++i)
+                {
+                    slots[i] = static_cast<uint8_t>(i);
+                    for (size_t j = 0; j < COUNT; ++j)
+                    {
+                        if (!Schema::FIELDS[i].primary.empty() && Schema::FIELDS[j].key == Schema::FIELDS[i].primary)
+                        {
+                            slots[i] = static_cast<uint8_t>(j);
+                            break;
+                        }
+                    }
+                }
+                return slots;
+            }();
+
+            // Bit i set in [c] if FIELDS[i].key starts with byte c
+            static constexpr std::array<uint32_t, 256> BY_FIRST_BYTE = []
+            {
+                std::array<uint32_t, 256> table{};
+                for (size_t i = 0; i < COUNT; ++i)
+                {
+                    table[static_cast<unsigned char>(Schema::FIELDS[i].key[0])] |= uint32_t(1) << i;
+                }
+                return table;
+            }();
+        };
+
+        /**
+         * Route one key/value to its field (false if the schema doesn't know the key)
+         * Only fields whose key starts with the same byte are compared, beginning at the
+         * cursor, so unknown keys are usually rejected without any comparison
+         */
+        template <typename Schema>
+        bool dispatch(simdjson::ondemand::raw_json_string key, simdjson::ondemand::value &val, typename Schema::Target &out, WalkState &state)
+        {
+            using Info = SchemaInfo<Schema>;
+            const uint32_t candidates = Info::BY_FIRST_BYTE[static_cast<unsigned char>(*key.raw())];
+            if (candidates == 0)
+            {
+                return false;
+            }
+
+            // Candidates at or after the cursor first, then the ones before it
+            const uint32_t fromCursor = candidates & (~uint32_t(0) << state.cursor);
+            for (uint32_t pending : {fromCursor, candidates & ~fromCursor})
+            {
+                while (pending != 0)
+                {
+                    const size_t i = static_cast<size_t>(__builtin_ctz(pending));
+                    pending &= pending - 1;
+
+                    const auto &field = Schema::FIELDS[i];
+                    if (!key.unsafe_is_equal(field.key))
+                    {
+                        continue;
+                    }
+
+                    state.cursor = i + 1 < Info::COUNT ? i + 1 : 0;
+                    if (field.isSymbol && state.symbolFromStream)
+                    {
+                        return true;
+                    }
+                    // Fallback key, but the primary key was already read
+                    const uint8_t slot = Info::SLOTS[i];
+                    uint8_t &filledBy = state.filledBy[slot];
+                    if (!field.primary.empty() && filledBy == slot)
+                    {
+                        return true;
+                    }
+                    if (field.read(val, out, state))
+                    {
+                        filledBy = static_cast<uint8_t>(i);
+                    }
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        template <typename Schema>
+        bool walkObject(simdjson::ondemand::object &object, typename Schema::Target &out, WalkState &state)
+        {
+            for (auto fieldResult : object)
+            {
+                if (fieldResult.error() != simdjson::SUCCESS)
+                {
+                    return false;
+                }
+                simdjson::ondemand::field &field = fieldResult.value_unsafe();
+                dispatch<Schema>(field.key(), field.value(), out, state);
+            }
+            return true;
+        }
+
+        template <typename Schema>
+        bool readObject(simdjson::ondemand::value &val, typename Schema::Target &out, WalkState &state)
+        {
+            simdjson::ondemand::object object;
+            if (val.get_object().get(object) != simdjson::SUCCESS)
+            {
+                return false;
+            }
+            return walkObject<Schema>(object, out, state);
+        }
+
+        /**
+         * Check required fields
+         */
+        template <typename Schema>
+        bool finish(typename Schema::Target &, const WalkState &state)
+        {
+            using Info = SchemaInfo<Schema>;
+
+            for (size_t i = 0; i < Info::COUNT; ++i)
+            {
+                if (Schema::FIELDS[i].required && state.filledBy[Info::SLOTS[i]] == WalkState::UNSET)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Parse json into out using Schema
+         * Returns false on malformed JSON or a missing required field
+         */
+        template <typename Schema>
+        bool parse(simdjson::ondemand::parser &parser, const std::string &json, typename Schema::Target &out)
+        {
+            // Parse in place if json has padding slack, else copy into the thread's arena
+            auto docResult = parser.iterate(PaddedArena::local().prepare(json));
+            if (docResult.error() != simdjson::SUCCESS)
+            {
+                return false;
+            }
+            simdjson::ondemand::document &doc = docResult.value();
+            simdjson::ondemand::object root;
+            if (doc.get_object().get(root) != simdjson::SUCCESS)
+            {
+                return false;
+            }
+
+            WalkState state;
+            for (auto fieldResult : root)
+            {
+                if (fieldResult.error() != simdjson::SUCCESS)
+                {
+                    return false;
+                }
+                simdjson::ondemand::field &field = fieldResult.value_unsafe();
+                const simdjson::ondemand::raw_json_string key = field.key();
+
+                if (key.unsafe_is_equal("stream"))
+                {
+                    // Stream format: {"stream":"btcusdt@depth","data":{...}}
+                    std::string_view stream;
+                    if (Schema::SYMBOL_FROM_STREAM && field.value().get_string().get(stream) == simdjson::SUCCESS)
+                    {
+                        // "!ticker@arr"-style streams carry no single symbol
+                        const size_t atPos = stream.find('@');
+                        if (atPos != std::string_view::npos && atPos > 0 && stream[0] != '!')
+                        {
+                            JsonExtract::copyToFixedBuffer(stream.substr(0, atPos), out.symbol, sizeof(out.symbol), out.symbolLen);
+                            state.symbolFromStream = true;
+                        }
+                    }
+                }
+                else if (key.unsafe_is_equal("data"))
+                {
+                    simdjson::ondemand::object data;
+                    if (field.value().get_object().get(data) == simdjson::SUCCESS && !walkObject<Schema>(data, out, state))
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    // Direct format field, or an envelope field such as "wsTime"
+                    dispatch<Schema>(key, field.value(), out, state);
+                }
+            }
+
+            return finish<Schema>(out, state);
+        }
+
+        /**
+         * Parse an array of Schema objects into out (cleared first)
+         * Accepts a bare array or a stream envelope whose "data" is an array
+         * ({"stream":"!miniTicker@arr","data":[...]}); invalid elements are skipped
+         */
+        template <typename Schema>
+        bool parseArray(simdjson::ondemand::parser &parser, const std::string &json, std::vector<typename Schema::Target> &out)
+        {
+            out.clear();
+            auto docResult = parser.iterate(PaddedArena::local().prepare(json));
+            if (docResult.error() != simdjson::SUCCESS)
+            {
+                return false;
+            }
+            simdjson::ondemand::document &doc = docResult.value();
+
+            simdjson::ondemand::array items;
+            simdjson::ondemand::object root;
+            if (doc.get_array().get(items) != simdjson::SUCCESS)
+            {
+                if (doc.get_object().get(root) != simdjson::SUCCESS || root["data"].get_array().get(items) != simdjson::SUCCESS)
+                {
+                    return false;
+                }
+            }
+
+            for (auto itemResult : items)
+            {
+                if (itemResult.error() != simdjson::SUCCESS)
+                {
+                    return false;
+                }
+                typename Schema::Target item{};
+                WalkState state;
+                if (readObject<Schema>(itemResult.value_unsafe(), item, state) && finish<Schema>(item, state))
+                {
+                    out.push_back(item);
+                }
+            }
+            return true;
+        }
+    }
+}
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * Locale-independent double -> decimal string formatting
+     *
+     * Features:
+     * - Fixed precision: value is scaled to an integer and written with integer
+     *   std::to_chars (no locale, no iostream, no trailing-zero stripping)
+     * - Shortest round-trip (SHORTEST): fewest decimals that parse back to the
+     *   exact same double, so sub-satoshi quantities are never truncated
+     * - Writes into a caller buffer; format()/formatTo() results fit the
+     *   std::string small buffer for typical prices (no heap allocation)
+     * - Falls back to snprintf only for values outside the exact integer range
+     */
+    class NumberFormatter
+    {
+    public:
+        static constexpr int SHORTEST = -1;     // Decimals: shortest round-trip representation
+        static constexpr int MAX_DECIMALS = 17; // Enough for any double in (1e-17, 2^53)
+        static constexpr size_t BUFFER_SIZE = 352; // Worst case "%.17f" of DBL_MAX plus sign/NUL
+
+    private:
+        static constexpr double POW10[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+            1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17};
+
+        static constexpr double MAX_EXACT_INTEGER = 9007199254740992.0; // 2^53
+        static constexpr double MAX_SCALED_INTEGER = 9.2e18;            // Below INT64_MAX
+
+        static size_t writeNonFinite(char *out, double value)
+        {
+            // Same spelling as std::to_string
+            const char *text = std::isnan(value) ? "nan" : (value < 0 ? "-inf" : "inf");
+            const size_t length = std::char_traits<char>::length(text);
+            std::copy(text, text + length, out);
+            return length;
+        }
+
+        static size_t writeFallback(char *out, double value, int decimals)
+        {
+            const int written = decimals < 0
+                                    ? std::snprintf(out, BUFFER_SIZE, "%.17g", value)
+                                    : std::snprintf(out, BUFFER_SIZE, "%.*f", decimals, value);
+            return written > 0 ? std::min(static_cast<size_t>(written), BUFFER_SIZE - 1) : 0;
+        }
+
+    public:
+        /**
+         * Write scaled / 10^decimals as a decimal string, '-' prefixed if negative and non-zero
+         * (shared with Decimal, which stores exactly this scaled-integer form)
+         */
+        static size_t writeScaled(char *out, uint64_t scaled, int decimals, bool negative)
+        {
+            char digits[24];
+            const auto result = std::to_chars(digits, digits + sizeof(digits), scaled);
+            const size_t digitCount = static_cast<size_t>(result.ptr - digits);
+
+            char *pos = out;
+            if (negative && scaled != 0)
+            {
+                *pos++ = '-';
+            }
+
+            const size_t fraction = static_cast<size_t>(decimals);
+            if (digitCount > fraction)
+            {
+                // Integer part, then fractional part
+                const size_t integerDigits = digitCount - fraction;
+                std::copy(digits, digits + integerDigits, pos);
+                pos += integerDigits;
+                if (fraction > 0)
+                {
+                    *pos++ = '.';
+                    std::copy(digits + integerDigits, digits + digitCount, pos);
+                    pos += fraction;
+                }
+            }
+            else
+            {
+                // 0.000ddd
+                *pos++ = '0';
+                *pos++ = '.';
+                std::fill(pos, pos + (fraction - digitCount), '0');
+                pos += fraction - digitCount;
+                std::copy(digits, digits + digitCount, pos);
+                pos += digitCount;
+            }
+            return static_cast<size_t>(pos - out);
+        }
+
+        /**
+         * Write value into out (must hold BUFFER_SIZE chars, not NUL-terminated)
+         * decimals: fixed number of decimals (clamped to MAX_DECIMALS) or SHORTEST
+         * Returns number of chars written
+         */
+        static size_t write(char *out, double value, int decimals = SHORTEST)
+        {
+            if (!std::isfinite(value))
+            {
+                return writeNonFinite(out, value);
+            }
+
+            const bool negative = std::signbit(value);
+            const double magnitude = std::fabs(value);
+
+            if (decimals >= 0)
+            {
+                decimals = std::min(decimals, MAX_DECIMALS);
+                const double scaled = std::nearbyint(magnitude * POW10[decimals]);
+                if (scaled < MAX_SCALED_INTEGER)
+                {
+                    return writeScaled(out, static_cast<uint64_t>(scaled), decimals, negative);
+                }
+                return writeFallback(out, value, decimals);
+            }
+
+            // Shortest round-trip: smallest d where scaled / 10^d is exactly value again.
+            // scaled and 10^d are exact doubles, so the correctly rounded division equals
+            // what a correct parser (fast_float, strtod) returns for the written string.
+            for (int d = 0; d <= MAX_DECIMALS; ++d)
+            {
+                const double scaled = std::nearbyint(magnitude * POW10[d]);
+                if (scaled > MAX_EXACT_INTEGER)
+                {
+                    break;
+                }
+                if (scaled / POW10[d] == magnitude)
+                {
+                    return writeScaled(out, static_cast<uint64_t>(scaled), d, negative);
+                }
+            }
+            return writeFallback(out, value, SHORTEST);
+        }
+
+        /**
+         * Format into a reusable string (keeps its capacity)
+         */
+        static void formatTo(std::string &out, double value, int decimals = SHORTEST)
+        {
+            char buffer[BUFFER_SIZE];
+            out.assign(buffer, write(buffer, value, decimals));
+        }
+
+        static std::string format(double value, int decimals = SHORTEST)
+        {
+            char buffer[BUFFER_SIZE];
+            return std::string(buffer, write(buffer, value, decimals));
+        }
+    };
+
+    /**
+     * Display precision for one symbol (NumberFormatter::SHORTEST = shortest round-trip)
+     */
+    struct SymbolPrecision
+    {
+        int priceDecimals = NumberFormatter::SHORTEST;
+        int quantityDecimals = NumberFormatter::SHORTEST;
+    };
+
+    /**
+     * Per-symbol precision set from JS (setSymbolPrecision), read by DataConverter
+     *
+     * Features:
+     * - Symbols are matched case-insensitively ("BTCUSDT" == "btcusdt")
+     * - Lookups skip the lock entirely until the first precision is registered
+     * - Leaked singleton: safe to use from stream workers during static destruction
+     */
+    class SymbolPrecisionRegistry
+    {
+    private:
+        std::unordered_map<std::string, SymbolPrecision> precisions_;
+        mutable std::shared_mutex mutex_;
+        std::atomic<bool> hasEntries_{false};
+
+        static std::string normalize(std::string_view symbol)
+        {
+            std::string key(symbol);
+            for (char &c : key)
+            {
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+            return key;
+        }
+
+        SymbolPrecisionRegistry() = default;
+
+    public:
+        static SymbolPrecisionRegistry &instance()
+        {
+            static SymbolPrecisionRegistry *registry = new SymbolPrecisionRegistry();
+            return *registry;
+        }
+
+        void set(std::string_view symbol, SymbolPrecision precision)
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            precisions_[normalize(symbol)] = precision;
+            hasEntries_.store(true, std::memory_order_release);
+        }
+
+        /**
+         * Precision for symbol (SHORTEST for both if none registered)
+         */
+        SymbolPrecision get(std::string_view symbol) const
+        {
+            if (!hasEntries_.load(std::memory_order_acquire))
+            {
+                return SymbolPrecision{};
+            }
+
+            const std::string key = normalize(symbol);
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = precisions_.find(key);
+            return it != precisions_.end() ? it->second : SymbolPrecision{};
+        }
+
+        void clear()
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            precisions_.clear();
+            hasEntries_.store(false, std::memory_order_release);
+        }
+    };
+}
@@ -0,0 +1,364 @@
+#pragma once
+
+#include "DataStructs.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * One side of an L2 book: price levels in a flat sorted array
+     *
+     * Features:
+     * - Sorted worst -> best (best level at the back): changes near the top of the
+     *   book, the common case, move only the few levels behind them
+     * - Binary search per update; zero quantity removes the level
+     * - Depth cap drops the worst levels
+     */
+    template <bool IsBid>
+    class OrderBookSide
+    {
+    private:
+        std::vector<PriceLevel> levels_;
+
+        // Storage order: a before b if a's price is worse
+        static bool worse(const PriceLevel &level, Decimal price)
+        {
+            return IsBid ? level.price < price : level.price > price;
+        }
+
+    public:
+        /**
+         * Set, replace or (zero quantity) remove the level at price
+         * Returns the previous quantity (zero if the level was absent)
+         */
+        Decimal update(Decimal price, Decimal quantity)
+        {
+            auto it = std::lower_bound(levels_.begin(), levels_.end(), price, worse);
+            const bool found = it != levels_.end() && it->price == price;
+            const Decimal previous = found ? it->quantity : Decimal();
+            if (quantity.isZero())
+            {
+                if (found)
+                {
+                    levels_.erase(it);
+                }
+            }
+            else if (found)
+            {
+                it->quantity = quantity;
+            }
+            else
+            {
+                levels_.insert(it, PriceLevel{price, quantity});
+            }
+            return previous;
+        }
+
+        /**
+         * Add delta to the quantity at price (level created/removed as needed)
+         */
+        void adjust(Decimal price, Decimal delta)
+        {
+            auto it = std::lower_bound(levels_.begin(), levels_.end(), price, worse);
+            if (it != levels_.end() && it->price == price)
+            {
+                it->quantity += delta;
+                if (!it->quantity.isPositive())
+                {
+                    levels_.erase(it);
+                }
+            }
+            else if (delta.isPositive())
+            {
+                levels_.insert(it, PriceLevel{price, delta});
+            }
+        }
+
+        /**
+         * Replace all levels (snapshot); any input order, zero quantities skipped
+         */
+        void replace(const PriceLevel *levels, size_t count)
+        {
+            levels_.clear();
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (!levels[i].quantity.isZero())
+                {
+                    levels_.push_back(levels[i]);
+                }
+            }
+            std::sort(levels_.begin(), levels_.end(), [](const PriceLevel &a, const PriceLevel &b)
+                      { return worse(a, b.price); });
+        }
+
+        /**
+         * Keep the best maxLevels levels, onRemoved(level) called for each dropped one
+         */
+        template <typename OnRemoved>
+        void trim(size_t maxLevels, OnRemoved &&onRemoved)
+        {
+            if (levels_.size() > maxLevels)
+            {
+                const auto end = levels_.begin() + static_cast<std::ptrdiff_t>(levels_.size() - maxLevels);
+                for (auto it = levels_.begin(); it != end; ++it)
+                {
+                    onRemoved(*it);
+                }
+                levels_.erase(levels_.begin(), end);
+            }
+        }
+
+        void clear() { levels_.clear(); }
+
+        void reserve(size_t levels) { levels_.reserve(levels); }
+        size_t size() const { return levels_.size(); }
+        bool empty() const { return levels_.empty(); }
+
+        /**
+         * rank-th best level (0 = best bid / best ask)
+         */
+        const PriceLevel &level(size_t rank) const { return levels_[levels_.size() - 1 - rank]; }
+    };
+
+    /**
+     * Book grouped by a tick size (e.g. 0.1, 1, 10), kept in sync level by level
+     *
+     * Features:
+     * - Bids round down and asks round up to their bucket, so buckets never cross
+     * - Each changed level moves its bucket total by the quantity difference:
+     *   no regrouping of the whole book per update
+     * - Exact Decimal sums, so a bucket emptied by deltas is removed exactly
+     */
+    class OrderBookLadder
+    {
+    private:
+        Decimal tick_;
+        OrderBookSide<true> bids_;
+        OrderBookSide<false> asks_;
+
+        /**
+         * Bucket price of price (multiple of tick_), price itself if the scales can't be aligned
+         */
+        Decimal bucketOf(Decimal price, bool roundUp) const
+        {
+            const int scale = std::max(price.scale(), tick_.scale());
+            const Decimal alignedPrice = price.rescaled(scale);
+            const Decimal alignedTick = tick_.rescaled(scale);
+            if (alignedPrice.scale() != scale || alignedTick.scale() != scale)
+            {
+                return price;
+            }
+            const int64_t step = alignedTick.mantissa();
+            int64_t bucket = alignedPrice.mantissa() / step;
+            if (roundUp && bucket * step < alignedPrice.mantissa())
+            {
+                ++bucket;
+            }
+            return Decimal::fromRaw(bucket * step, scale);
+        }
+
+    public:
+        explicit OrderBookLadder(Decimal tick) : tick_(tick) {}
+
+        void onBid(Decimal price, Decimal previous, Decimal quantity)
+        {
+            bids_.adjust(bucketOf(price, false), quantity - previous);
+        }
+
+        void onAsk(Decimal price, Decimal previous, Decimal quantity)
+        {
+            asks_.adjust(bucketOf(price, true), quantity - previous);
+        }
+
+        void clear()
+        {
+            bids_.clear();
+            asks_.clear();
+        }
+
+        Decimal tick() const { return tick_; }
+        const OrderBookSide<true> &bids() const { return bids_; }
+        const OrderBookSide<false> &asks() const { return asks_; }
+    };
+
+    /**
+     * Native L2 order book for one symbol
+     *
+     * Features:
+     * - Snapshots (partial book / REST) replace both sides, deltas are merged level by level
+     * - Depth capped per side (DEFAULT_DEPTH_LIMIT unless set), capacity reserved up front
+     *   so steady-state updates never allocate
+     * - Tracks the last applied update id for sequence checks
+     * - Optional aggregation ladders (setAggregations) updated from the changed levels only,
+     *   so every tick size is ready to display without regrouping
+     */
+    class OrderBook
+    {
+    public:
+        static constexpr size_t DEFAULT_DEPTH_LIMIT = 1000;
+
+    private:
+        OrderBookSide<true> bids_;
+        OrderBookSide<false> asks_;
+        size_t depthLimit_;
+        uint64_t lastUpdateId_ = 0;
+        std::vector<OrderBookLadder> ladders_;
+
+        void updateBid(Decimal price, Decimal quantity)
+        {
+            const Decimal previous = bids_.update(price, quantity);
+            if (previous != quantity)
+            {
+                for (OrderBookLadder &ladder : ladders_)
+                {
+                    ladder.onBid(price, previous, quantity);
+                }
+            }
+        }
+
+        void updateAsk(Decimal price, Decimal quantity)
+        {
+            const Decimal previous = asks_.update(price, quantity);
+            if (previous != quantity)
+            {
+                for (OrderBookLadder &ladder : ladders_)
+                {
+                    ladder.onAsk(price, previous, quantity);
+                }
+            }
+        }
+
+        void trim()
+        {
+            bids_.trim(depthLimit_, [this](const PriceLevel &level)
+                       {
+                           for (OrderBookLadder &ladder : ladders_)
+                           {
+                               ladder.onBid(level.price, level.quantity, Decimal());
+                           } });
+            asks_.trim(depthLimit_, [this](const PriceLevel &level)
+                       {
+                           for (OrderBookLadder &ladder : ladders_)
+                           {
+                               ladder.onAsk(level.price, level.quantity, Decimal());
+                           } });
+        }
+
+        void rebuildLadders()
+        {
+            for (OrderBookLadder &ladder : ladders_)
+            {
+                ladder.clear();
+                // Worst level first: buckets are appended at the best end
+                for (size_t i = bids_.size(); i-- > 0;)
+                {
+                    ladder.onBid(bids_.level(i).price, Decimal(), bids_.level(i).quantity);
+                }
+                for (size_t i = asks_.size(); i-- > 0;)
+                {
+                    ladder.onAsk(asks_.level(i).price, Decimal(), asks_.level(i).quantity);
+                }
+            }
+        }
+
+        void replace(uint64_t lastUpdateId, const PriceLevel *bids, size_t bidsCount, const PriceLevel *asks, size_t asksCount)
+        {
+            bids_.replace(bids, bidsCount);
+            asks_.replace(asks, asksCount);
+            bids_.trim(depthLimit_, [](const PriceLevel &) {});
+            asks_.trim(depthLimit_, [](const PriceLevel &) {});
+            lastUpdateId_ = lastUpdateId;
+            rebuildLadders();
+        }
+
+    public:
+        explicit OrderBook(size_t depthLimit = DEFAULT_DEPTH_LIMIT) : depthLimit_(depthLimit)
+        {
+            // Inserts may briefly exceed the cap by one message's levels before trim()
+            bids_.reserve(depthLimit_ + MAX_DEPTH_LEVELS);
+            asks_.reserve(depthLimit_ + MAX_DEPTH_LEVELS);
+        }
+
+        /**
+         * Apply a parsed depth message (snapshot or delta)
+         */
+        void apply(const DepthData &data)
+        {
+            if (data.isSnapshot)
+            {
+                replace(data.lastUpdateId, data.bids.data(), data.bidsCount, data.asks.data(), data.asksCount);
+                return;
+            }
+
+            for (size_t i = 0; i < data.bidsCount; ++i)
+            {
+                updateBid(data.bids[i].price, data.bids[i].quantity);
+            }
+            for (size_t i = 0; i < data.asksCount; ++i)
+            {
+                updateAsk(data.asks[i].price, data.asks[i].quantity);
+            }
+            lastUpdateId_ = data.finalUpdateId;
+            trim();
+        }
+
+        /**
+         * Replace the book with a REST snapshot
+         */
+        void apply(const DepthSnapshotData &snapshot)
+        {
+            replace(snapshot.lastUpdateId, snapshot.bids.data(), snapshot.bids.size(), snapshot.asks.data(), snapshot.asks.size());
+        }
+
+        /**
+         * Tick sizes to keep grouped ladders for (non-positive ticks ignored)
+         */
+        void setAggregations(const std::vector<Decimal> &ticks)
+        {
+            ladders_.clear();
+            for (Decimal tick : ticks)
+            {
+                if (tick.isPositive() && ladder(tick) == nullptr)
+                {
+                    ladders_.emplace_back(tick);
+                }
+            }
+            rebuildLadders();
+        }
+
+        /**
+         * Ladder for tick, nullptr if not maintained
+         */
+        const OrderBookLadder *ladder(Decimal tick) const
+        {
+            for (const OrderBookLadder &candidate : ladders_)
+            {
+                if (candidate.tick() == tick)
+                {
+                    return &candidate;
+                }
+            }
+            return nullptr;
+        }
+
+        void clear()
+        {
+            bids_.clear();
+            asks_.clear();
+            lastUpdateId_ = 0;
+            for (OrderBookLadder &ladder : ladders_)
+            {
+                ladder.clear();
+            }
+        }
+
+        const OrderBookSide<true> &bids() const { return bids_; }
+        const OrderBookSide<false> &asks() const { return asks_; }
+        uint64_t lastUpdateId() const { return lastUpdateId_; }
+        size_t depthLimit() const { return depthLimit_; }
+        const std::vector<OrderBookLadder> &ladders() const { return ladders_; }
+    };
+}
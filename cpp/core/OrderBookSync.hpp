@@ -0,0 +1,207 @@
+#pragma once
+
+#include "DataStructs.hpp"
+#include "OrderBook.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * Sequence-checked order book for one symbol (diff depth stream + REST snapshot)
+     *
+     * Features:
+     * - AWAITING_SNAPSHOT: deltas are buffered (bounded, oldest dropped) until a
+     *   snapshot arrives, then replayed on top of it
+     * - SYNCED: deltas already covered by the book (u <= lastUpdateId) are discarded,
+     *   the next one must satisfy U <= lastUpdateId + 1 <= u
+     * - A gap (dropped frame, ring overwrite) returns to AWAITING_SNAPSHOT and reports
+     *   RESYNC_NEEDED once, instead of silently corrupting the book
+     * - Partial book stream snapshots (depth5/10/20) sync the book on their own
+     * - A delta with more levels than DepthData holds is never applied (that would
+     *   lose updates): the book waits for a snapshot past it and reports RESYNC_NEEDED
+     * - Without a resync handler (nobody can load a snapshot) a delta that can't be
+     *   sequence-checked is applied as is and the book is reported unsynced
+     */
+    class OrderBookSync
+    {
+    public:
+        static constexpr size_t MAX_PENDING_DELTAS = 256; // Deltas buffered while awaiting a snapshot
+
+        enum class State : uint8_t
+        {
+            AWAITING_SNAPSHOT,
+            SYNCED
+        };
+
+        enum class Result : uint8_t
+        {
+            APPLIED,      // Book changed
+            BUFFERED,     // Held until a snapshot arrives
+            STALE,        // Already covered by the book (or truncated while a resync is pending), discarded
+            RESYNC_NEEDED // No usable snapshot (first delta, gap, truncated delta, or snapshot older than the buffer)
+        };
+
+    private:
+        OrderBook book_;
+        State state_ = State::AWAITING_SNAPSHOT;
+        std::deque<DepthData> pending_;
+        bool resyncReported_ = false; // RESYNC_NEEDED already returned for this wait
+
+        Result buffer(const DepthData &delta)
+        {
+            if (pending_.size() >= MAX_PENDING_DELTAS)
+            {
+                pending_.pop_front(); // The snapshot still to come is newer than the oldest deltas
+            }
+            pending_.push_back(delta);
+            if (!resyncReported_)
+            {
+                resyncReported_ = true;
+                return Result::RESYNC_NEEDED;
+            }
+            return Result::BUFFERED;
+        }
+
+        /**
+         * Truncated delta: drop it and everything buffered before it
+         * Deltas buffered after it start past its range, so replaying them on a snapshot
+         * older than it fails the gap check and asks for another one
+         */
+        Result dropTruncated()
+        {
+            state_ = State::AWAITING_SNAPSHOT;
+            pending_.clear();
+            if (!resyncReported_)
+            {
+                resyncReported_ = true;
+                return Result::RESYNC_NEEDED;
+            }
+            return Result::STALE;
+        }
+
+        void markSynced()
+        {
+            state_ = State::SYNCED;
+            resyncReported_ = false;
+        }
+
+        /**
+         * Best effort when no snapshot can be requested: build the book from the deltas alone
+         * The book stays AWAITING_SNAPSHOT, so a handler registered later gets RESYNC_NEEDED
+         */
+        Result applyUnsequenced(const DepthData &delta)
+        {
+            state_ = State::AWAITING_SNAPSHOT;
+            pending_.clear();
+            resyncReported_ = false;
+            if (delta.finalUpdateId <= book_.lastUpdateId())
+            {
+                return Result::STALE;
+            }
+            book_.apply(delta);
+            return Result::APPLIED;
+        }
+
+    public:
+        explicit OrderBookSync(size_t depthLimit = OrderBook::DEFAULT_DEPTH_LIMIT) : book_(depthLimit) {}
+
+        /**
+         * Apply a depth stream message (partial book snapshot or delta)
+         * canResync: a resync handler is registered and can answer RESYNC_NEEDED with a snapshot
+         */
+        Result onDepth(const DepthData &data, bool canResync = true)
+        {
+            if (data.isSnapshot)
+            {
+                book_.apply(data);
+                pending_.clear();
+                markSynced();
+                return Result::APPLIED;
+            }
+
+            const bool inSequence = isSynced() && !data.levelsTruncated &&
+                                    data.firstUpdateId <= book_.lastUpdateId() + 1;
+            if (!canResync && !inSequence)
+            {
+                return applyUnsequenced(data);
+            }
+
+            if (data.levelsTruncated)
+            {
+                return data.finalUpdateId <= book_.lastUpdateId() && isSynced() ? Result::STALE : dropTruncated();
+            }
+
+            if (state_ == State::AWAITING_SNAPSHOT)
+            {
+                return buffer(data);
+            }
+
+            const uint64_t lastUpdateId = book_.lastUpdateId();
+            if (data.finalUpdateId <= lastUpdateId)
+            {
+                return Result::STALE;
+            }
+            if (data.firstUpdateId > lastUpdateId + 1)
+            {
+                // Gap: updates between lastUpdateId and U were lost
+                state_ = State::AWAITING_SNAPSHOT;
+                pending_.clear();
+                return buffer(data);
+            }
+            book_.apply(data);
+            return Result::APPLIED;
+        }
+
+        /**
+         * Load a REST snapshot and replay the buffered deltas on top of it
+         * Returns RESYNC_NEEDED if the snapshot is older than the buffered deltas
+         */
+        Result onSnapshot(const DepthSnapshotData &snapshot)
+        {
+            book_.apply(snapshot);
+            markSynced();
+
+            while (!pending_.empty())
+            {
+                const DepthData &delta = pending_.front();
+                const uint64_t lastUpdateId = book_.lastUpdateId();
+                if (delta.finalUpdateId <= lastUpdateId)
+                {
+                    pending_.pop_front(); // Already in the snapshot
+                    continue;
+                }
+                if (delta.firstUpdateId > lastUpdateId + 1)
+                {
+                    // Snapshot too old: keep the buffer for the next one
+                    state_ = State::AWAITING_SNAPSHOT;
+                    resyncReported_ = true;
+                    return Result::RESYNC_NEEDED;
+                }
+                book_.apply(delta);
+                pending_.pop_front();
+            }
+            return Result::APPLIED;
+        }
+
+        /**
+         * Deltas may have been lost before reaching the book (e.g. dropped raw frames):
+         * wait for a snapshot; the next delta reports RESYNC_NEEDED
+         */
+        void invalidate()
+        {
+            state_ = State::AWAITING_SNAPSHOT;
+            pending_.clear();
+            resyncReported_ = false;
+        }
+
+        void setAggregations(const std::vector<Decimal> &ticks) { book_.setAggregations(ticks); }
+
+        bool isSynced() const { return state_ == State::SYNCED; }
+        State state() const { return state_; }
+        size_t pendingCount() const { return pending_.size(); }
+        const OrderBook &book() const { return book_; }
+    };
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "DataStructs.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * Row-level patches between the order book views delivered to JS (one symbol)
+     *
+     * Features:
+     * - Sorted merge of the previous and next rows by price: INSERT / UPDATE / REMOVE by
+     *   row index, applied in order to the previous view they rebuild the next one
+     * - A row is UPDATEd only if its [price, quantity] changed, so a one-level change is
+     *   one op; unchanged rows are not sent
+     * - Cumulative quantities and bar ratios shift for every row behind a change (and
+     *   ratios on both sides with the shared scale): each side's arrays are flagged as a
+     *   whole when they changed, instead of per-row updates
+     * - Depth charts are flagged only when they changed (always on keyframes)
+     * - Version +1 per patch so JS can detect a missed one (requestKeyframe())
+     * - Keyframe (whole view as inserts into an empty view) on the first patch, every
+     *   keyframeInterval patches, on request, or when the diff is larger than the view
+     * - Views with no visible change produce no patch
+     *
+     * Views are OrderBookDataItem-shaped: bids/asks rows with their *Cumulative,
+     * *BarRatios and *DepthChart arrays (kept nitro-free as a template parameter)
+     */
+    class OrderBookViewDiff
+    {
+    public:
+        static constexpr uint32_t DEFAULT_KEYFRAME_INTERVAL = 100; // Patches between keyframes
+
+        using Rows = std::vector<std::tuple<std::string, std::string>>; // [price, quantity], best first
+
+        enum class OpType : uint8_t
+        {
+            INSERT = 0,
+            UPDATE = 1,
+            REMOVE = 2
+        };
+
+        struct Op
+        {
+            OpType type;
+            uint32_t index; // Row index at the time the op is applied (best = 0)
+            uint32_t row;   // Source row in the next view (unused for REMOVE)
+        };
+
+        struct Patch
+        {
+            uint64_t version = 0;
+            bool keyframe = false;
+            std::vector<Op> bids;
+            std::vector<Op> asks;
+            bool bidDepthChanged = false; // Cumulative quantities or bar ratios
+            bool askDepthChanged = false;
+            bool bidChartChanged = false;
+            bool askChartChanged = false;
+        };
+
+    private:
+        struct Side
+        {
+            Rows rows;
+            std::vector<Decimal> prices; // Parsed once per delivered view, for the merge order
+            std::vector<double> cumulative;
+            std::vector<double> barRatios;
+            std::vector<double> chart;
+
+            bool sameDepth(const Side &other) const
+            {
+                return cumulative == other.cumulative && barRatios == other.barRatios;
+            }
+        };
+
+        Side bids_;
+        Side asks_;
+        uint64_t version_ = 0;
+        uint32_t keyframeInterval_;
+        uint32_t sinceKeyframe_ = 0;
+        bool keyframeRequested_ = true; // JS has no view yet
+
+        static std::vector<Decimal> parsePrices(const Rows &rows)
+        {
+            std::vector<Decimal> prices;
+            prices.reserve(rows.size());
+            for (const auto &row : rows)
+            {
+                Decimal price;
+                Decimal::parse(std::get<0>(row), price); // Formatted by DataConverter: always valid
+                prices.push_back(price);
+            }
+            return prices;
+        }
+
+        // True if a comes before b in the side's row order (best first)
+        template <bool IsBid>
+        static bool before(Decimal a, Decimal b)
+        {
+            return IsBid ? a > b : a < b;
+        }
+
+        static Side makeSide(const Rows &rows, const std::vector<double> &cumulative, const std::vector<double> &barRatios, const std::vector<double> &chart)
+        {
+            return Side{rows, parsePrices(rows), cumulative, barRatios, chart};
+        }
+
+        template <bool IsBid>
+        static void diffSide(const Side &previous, const Side &next, std::vector<Op> &ops)
+        {
+            size_t i = 0; // Previous view
+            size_t j = 0; // Next view
+            uint32_t index = 0;
+            while (i < previous.rows.size() || j < next.rows.size())
+            {
+                if (j == next.rows.size() || (i < previous.rows.size() && before<IsBid>(previous.prices[i], next.prices[j])))
+                {
+                    ops.push_back(Op{OpType::REMOVE, index, 0}); // Price gone (or scrolled out of the view)
+                    ++i;
+                }
+                else if (i == previous.rows.size() || before<IsBid>(next.prices[j], previous.prices[i]))
+                {
+                    ops.push_back(Op{OpType::INSERT, index++, static_cast<uint32_t>(j++)});
+                }
+                else
+                {
+                    if (previous.rows[i] != next.rows[j])
+                    {
+                        ops.push_back(Op{OpType::UPDATE, index, static_cast<uint32_t>(j)});
+                    }
+                    ++i;
+                    ++j;
+                    ++index;
+                }
+            }
+        }
+
+        static void insertAll(const Rows &rows, std::vector<Op> &ops)
+        {
+            ops.clear();
+            ops.reserve(rows.size());
+            for (uint32_t j = 0; j < rows.size(); ++j)
+            {
+                ops.push_back(Op{OpType::INSERT, j, j});
+            }
+        }
+
+    public:
+        explicit OrderBookViewDiff(uint32_t keyframeInterval = DEFAULT_KEYFRAME_INTERVAL) : keyframeInterval_(keyframeInterval) {}
+
+        /**
+         * Patch from the last delivered view to view, which becomes the delivered view
+         * Returns false (no patch, version unchanged) if nothing visible changed
+         */
+        template <typename View>
+        bool next(const View &view, Patch &patch)
+        {
+            Side bids = makeSide(view.bids, view.bidCumulative, view.bidBarRatios, view.bidDepthChart);
+            Side asks = makeSide(view.asks, view.askCumulative, view.askBarRatios, view.askDepthChart);
+
+            patch.bids.clear();
+            patch.asks.clear();
+            bool keyframe = keyframeRequested_ || sinceKeyframe_ >= keyframeInterval_;
+            patch.bidDepthChanged = keyframe || !bids.sameDepth(bids_);
+            patch.askDepthChanged = keyframe || !asks.sameDepth(asks_);
+            patch.bidChartChanged = keyframe || bids.chart != bids_.chart;
+            patch.askChartChanged = keyframe || asks.chart != asks_.chart;
+            if (!keyframe)
+            {
+                diffSide<true>(bids_, bids, patch.bids);
+                diffSide<false>(asks_, asks, patch.asks);
+                if (patch.bids.empty() && patch.asks.empty() && !patch.bidDepthChanged && !patch.askDepthChanged &&
+                    !patch.bidChartChanged && !patch.askChartChanged)
+                {
+                    return false;
+                }
+                keyframe = patch.bids.size() + patch.asks.size() > bids.rows.size() + asks.rows.size();
+            }
+
+            if (keyframe)
+            {
+                insertAll(bids.rows, patch.bids);
+                insertAll(asks.rows, patch.asks);
+                patch.bidDepthChanged = true;
+                patch.askDepthChanged = true;
+                patch.bidChartChanged = true;
+                patch.askChartChanged = true;
+                keyframeRequested_ = false;
+                sinceKeyframe_ = 0;
+            }
+            else
+            {
+                ++sinceKeyframe_;
+            }
+            patch.keyframe = keyframe;
+            patch.version = ++version_;
+
+            bids_ = std::move(bids);
+            asks_ = std::move(asks);
+            return true;
+        }
+
+        /**
+         * Make the next patch a keyframe (JS missed a version)
+         */
+        void requestKeyframe() { keyframeRequested_ = true; }
+
+        uint64_t version() const { return version_; }
+    };
+}
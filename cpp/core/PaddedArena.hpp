@@ -0,0 +1,96 @@
+#pragma once
+
+#include <simdjson.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * Grow-only padded input buffer for simdjson (one per thread via local())
+     *
+     * Features:
+     * - Tracks its own capacity: copying a message in never reallocates unless
+     *   the message is larger than any seen before on this thread
+     * - Growth is geometric, so a slowly growing stream reallocates O(log n) times
+     * - prepare() parses std::string input in place (no copy) when the string's
+     *   capacity already leaves SIMDJSON_PADDING bytes of slack
+     * - Returned views stay valid until the next prepare()/load() on the same thread
+     */
+    class PaddedArena
+    {
+    public:
+        static constexpr size_t INITIAL_CAPACITY = 4096;
+
+    private:
+        std::unique_ptr<char[]> data_;
+        size_t capacity_ = 0; // Usable bytes (padding excluded)
+
+        void reserve(size_t size)
+        {
+            if (size <= capacity_)
+            {
+                return;
+            }
+            const size_t capacity = std::max({size, capacity_ * 2, INITIAL_CAPACITY});
+            // Old contents are not preserved: every load() overwrites the buffer
+            data_.reset(new char[capacity + simdjson::SIMDJSON_PADDING]);
+            capacity_ = capacity;
+        }
+
+    public:
+        PaddedArena() = default;
+        PaddedArena(const PaddedArena &) = delete;
+        PaddedArena &operator=(const PaddedArena &) = delete;
+
+        /**
+         * Arena for the calling thread
+         */
+        static PaddedArena &local()
+        {
+            thread_local PaddedArena arena;
+            return arena;
+        }
+
+        /**
+         * True if json can be handed to simdjson as-is (enough slack after its bytes)
+         */
+        static bool hasPadding(const std::string &json)
+        {
+            return json.capacity() - json.size() >= simdjson::SIMDJSON_PADDING;
+        }
+
+        /**
+         * Copy json into the arena and return a padded view of the copy
+         */
+        simdjson::padded_string_view load(std::string_view json)
+        {
+            reserve(json.size());
+            if (!json.empty())
+            {
+                std::memcpy(data_.get(), json.data(), json.size());
+            }
+            // simdjson only needs the padding readable; zero it so stale bytes never look like JSON
+            std::memset(data_.get() + json.size(), 0, simdjson::SIMDJSON_PADDING);
+            return simdjson::padded_string_view(data_.get(), json.size(), json.size() + simdjson::SIMDJSON_PADDING);
+        }
+
+        /**
+         * Padded view of json: in place when it has enough slack, otherwise an arena copy
+         */
+        simdjson::padded_string_view prepare(const std::string &json)
+        {
+            if (hasPadding(json))
+            {
+                return simdjson::padded_string_view(json.data(), json.size(), json.capacity());
+            }
+            return load(json);
+        }
+
+        size_t capacity() const { return capacity_; }
+    };
+}
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "DataStructs.hpp"
+#include "MessageSchema.hpp"
 #include <simdjson.h>
 #include <string>
 #include <string_view>
 #include <cstring>
+#include <vector>
 
 namespace margelo::nitro::cxpmobile_tpsdk::core
 {
@@ -12,95 +14,17 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
      * Optimized simdjson parser for trading data
      *
      * Features:
-     * - Thread-local parser reuse
+     * - Thread-local parser reuse; input padded via the thread's PaddedArena
      * - Zero-copy string extraction using string_view
-     * - Only extracts needed fields
+     * - Allocation-free, exception-free number parsing (fast_float)
+     * - Only extracts needed fields, described by constexpr schemas (MessageSchema.hpp)
+     *   and read in a single order-aware pass over each object
      * - No intermediate JSON objects
      */
     class SimdjsonParser
     {
     private:
         thread_local static simdjson::ondemand::parser parser_;
-        thread_local static simdjson::padded_string padded_buffer_;
-        thread_local static size_t buffer_size_;
-
-        /**
-         * Copy string to fixed-size buffer (for symbol, status, etc.)
-         */
-        static void copyToFixedBuffer(std::string_view src, char *dst, size_t maxLen, uint8_t &outLen)
-        {
-            size_t len = std::min(src.length(), maxLen - 1);
-            std::memcpy(dst, src.data(), len);
-            dst[len] = '\0';
-            outLen = static_cast<uint8_t>(len);
-        }
-
-        /**
-         * Extract string from JSON value
-         */
-        static std::string_view extractString(simdjson::ondemand::value val)
-        {
-            auto strResult = val.get_string();
-            if (strResult.error() == simdjson::SUCCESS)
-            {
-                return std::string_view(strResult.value());
-            }
-            return std::string_view();
-        }
-
-        /**
-         * Extract double from JSON value
-         */
-        static double extractDouble(simdjson::ondemand::value val, double defaultValue = 0.0)
-        {
-            auto dblResult = val.get_double();
-            if (dblResult.error() == simdjson::SUCCESS)
-            {
-                return dblResult.value();
-            }
-            // Try as string (for high-precision numbers)
-            auto strResult = val.get_string();
-            if (strResult.error() == simdjson::SUCCESS)
-            {
-                std::string_view str = strResult.value();
-                // Simple string to double conversion
-                return std::stod(std::string(str));
-            }
-            return defaultValue;
-        }
-
-        /**
-         * Extract uint64 from JSON value
-         */
-        static uint64_t extractUint64(simdjson::ondemand::value val, uint64_t defaultValue = 0)
-        {
-            auto uintResult = val.get_uint64();
-            if (uintResult.error() == simdjson::SUCCESS)
-            {
-                return uintResult.value();
-            }
-            // Try as string
-            auto strResult = val.get_string();
-            if (strResult.error() == simdjson::SUCCESS)
-            {
-                std::string_view str = strResult.value();
-                return std::stoull(std::string(str));
-            }
-            return defaultValue;
-        }
-
-        /**
-         * Extract bool from JSON value
-         */
-        static bool extractBool(simdjson::ondemand::value val, bool defaultValue = false)
-        {
-            auto boolResult = val.get_bool();
-            if (boolResult.error() == simdjson::SUCCESS)
-            {
-                return boolResult.value();
-            }
-            return defaultValue;
-        }
 
     public:
         /**
@@ -109,6 +33,11 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
          */
         static bool parseDepth(const std::string &json, DepthData &out);
 
+        /**
+         * Parse REST depth snapshot (all levels); out.symbol must be set by the caller
+         */
+        static bool parseDepthSnapshot(const std::string &json, DepthSnapshotData &out);
+
         /**
          * Parse trade message
          */
@@ -124,6 +53,11 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
          */
         static bool parseMiniTicker(const std::string &json, MiniTickerData &out);
 
+        /**
+         * Parse all-market mini ticker array (!miniTicker@arr) into out
+         */
+        static bool parseMiniTickerArray(const std::string &json, std::vector<MiniTickerData> &out);
+
         /**
          * Parse kline message
          */
@@ -135,7 +69,7 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
         static bool parseUserData(const std::string &json, UserData &out);
 
         /**
-         * Detect message type from JSON string (quick detection without full parse)
+         * Detect message type from JSON string (stream name / event type, no parse; see MessageClassifier)
          */
         static MessageType detectMessageType(const std::string &json);
     };
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "DataStructs.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace margelo::nitro::cxpmobile_tpsdk::core
+{
+    /**
+     * Remembers the detected message type per stream name ("btcusdt@depth20@100ms")
+     *
+     * Features:
+     * - One direct-mapped table per routing thread (local()): no locks, no allocation
+     * - Stream name is read from the envelope prefix without parsing the message
+     * - A colliding stream simply evicts the slot (next frame re-probes)
+     * - Callers re-probe and update the entry when the cached type fails to parse
+     */
+    class StreamFormatCache
+    {
+    public:
+        static constexpr size_t SLOT_COUNT = 64; // Power of two
+        static constexpr size_t MAX_STREAM_LENGTH = 47;
+
+    private:
+        struct Slot
+        {
+            char name[MAX_STREAM_LENGTH];
+            uint8_t length = 0; // 0 = empty
+            MessageType type = MessageType::UNKNOWN;
+        };
+
+        std::array<Slot, SLOT_COUNT> slots_;
+
+        static size_t indexOf(std::string_view stream)
+        {
+            // Cheap mix of length and a few bytes that differ between streams
+            // ("btcusdt@depth" / "ethusdt@trade"); collisions are caught by the name compare
+            const size_t length = stream.size();
+            const size_t hash = length * 131 +
+                                static_cast<unsigned char>(stream[0]) * 31 +
+                                static_cast<unsigned char>(stream[length / 2]) * 7 +
+                                static_cast<unsigned char>(stream[length - 1]);
+            return hash & (SLOT_COUNT - 1);
+        }
+
+        static bool cacheable(std::string_view stream)
+        {
+            return !stream.empty() && stream.size() <= MAX_STREAM_LENGTH;
+        }
+
+    public:
+        static StreamFormatCache &local()
+        {
+            thread_local StreamFormatCache cache;
+            return cache;
+        }
+
+        /**
+         * Stream name of a combined-stream message ({"stream":"<name>",...}), empty otherwise
+         */
+        static std::string_view streamName(std::string_view json)
+        {
+            static constexpr std::string_view PREFIX = "{\"stream\":\"";
+            if (json.size() <= PREFIX.size() || json.compare(0, PREFIX.size(), PREFIX) != 0)
+            {
+                return std::string_view();
+            }
+            const size_t end = json.find('"', PREFIX.size());
+            if (end == std::string_view::npos)
+            {
+                return std::string_view();
+            }
+            return json.substr(PREFIX.size(), end - PREFIX.size());
+        }
+
+        /**
+         * Cached type for stream (false if not cached)
+         */
+        bool lookup(std::string_view stream, MessageType &type) const
+        {
+            if (!cacheable(stream))
+            {
+                return false;
+            }
+            const Slot &slot = slots_[indexOf(stream)];
+            if (slot.length != stream.size() || std::memcmp(slot.name, stream.data(), stream.size()) != 0)
+            {
+                return false;
+            }
+            type = slot.type;
+            return true;
+        }
+
+        void store(std::string_view stream, MessageType type)
+        {
+            if (!cacheable(stream) || type == MessageType::UNKNOWN)
+            {
+                return;
+            }
+            Slot &slot = slots_[indexOf(stream)];
+            std::memcpy(slot.name, stream.data(), stream.size());
+            slot.length = static_cast<uint8_t>(stream.size());
+            slot.type = type;
+        }
+
+        void invalidate(std::string_view stream)
+        {
+            MessageType cached;
+            if (lookup(stream, cached))
+            {
+                slots_[indexOf(stream)].length = 0;
+            }
+        }
+    };
+}
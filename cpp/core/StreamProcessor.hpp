@@ -1,79 +1,235 @@
 #pragma once
 
 #include "DataStructs.hpp"
-#include "RingBuffer.hpp"
-#include "ObjectPool.hpp"
+#include "LossyRingBuffer.hpp"
 #include "SimdjsonParser.hpp"
+#include "EventCount.hpp"
+#include "../threadpool/ThreadPool.hpp"
 #include <functional>
 #include <thread>
 #include <atomic>
 #include <memory>
+#include <new>
+#include <iostream>
+#include <span>
 
 namespace margelo::nitro::cxpmobile_tpsdk::core
 {
     /**
      * Stream Processor Base Class
      * Handles parsing and routing for each stream type
+     *
+     * Two executor modes:
+     * - Dedicated: one worker thread per stream (spin-then-park)
+     * - Shared: ring is drained by tasks on a ThreadPool shared by all streams.
+     *   At most one drain task per stream is in flight, so per-stream FIFO order
+     *   is preserved while idle pool workers pick up whichever stream is busy.
+     *
+     * Items are popped in batches (one index publish per batch). A batch
+     * callback receives each batch as one contiguous span; a per-item callback
+     * is invoked once per item.
      */
     template <typename DataType, size_t RingBufferSize>
     class StreamProcessor
     {
     public:
         using Callback = std::function<void(const DataType &)>;
-        using RingBufferType = RingBuffer<DataType, RingBufferSize>;
-        using ObjectPoolType = ObjectPool<DataType>;
+        using BatchCallback = std::function<void(std::span<const DataType>)>;
+        using RingBufferType = LossyRingBuffer<DataType, RingBufferSize>;
 
     private:
         RingBufferType ring_buffer_;
-        ObjectPoolType object_pool_;
         std::atomic<bool> running_{false};
         std::thread worker_thread_;
         Callback callback_;
+        BatchCallback batchCallback_;
+        std::unique_ptr<DataType[]> batch_; // Consumer-only: items popped by the current batch
+        EventCount wakeup_; // Parks the worker when the ring stays empty
 
-        void workerLoop()
+        // Shared executor mode (null in dedicated mode)
+        ThreadPool *pool_{nullptr};
+        alignas(64) std::atomic<bool> drainScheduled_{false};
+        std::atomic<uint32_t> drainsInFlight_{0}; // Queued or running drain tasks (stop() waits on it)
+
+        // Max items per batch (and per drain task before yielding the pool worker to other streams)
+        static constexpr size_t DRAIN_BUDGET = 64;
+
+        bool hasWork() const
         {
-            DataType item;
-            while (running_.load(std::memory_order_acquire))
+            return !ring_buffer_.empty() || !running_.load(std::memory_order_acquire);
+        }
+
+        /**
+         * Pop up to DRAIN_BUDGET items and hand them to the callback
+         * Returns number of items dispatched (0 if ring was empty)
+         */
+        size_t dispatchBatch()
+        {
+            const size_t count = ring_buffer_.pop_bulk(std::span<DataType>(batch_.get(), DRAIN_BUDGET));
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            try
             {
-                if (ring_buffer_.pop(item))
+                if (batchCallback_)
                 {
-                    if (callback_)
+                    batchCallback_(std::span<const DataType>(batch_.get(), count));
+                }
+                else if (callback_)
+                {
+                    for (size_t i = 0; i < count; ++i)
                     {
-                        callback_(item);
+                        callback_(batch_[i]);
                     }
                 }
-                else
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "[C++ ERROR] StreamProcessor callback exception: " << e.what() << std::endl;
+            }
+            return count;
+        }
+
+        void workerLoop()
+        {
+            while (running_.load(std::memory_order_acquire))
+            {
+                if (dispatchBatch() > 0)
+                {
+                    continue;
+                }
+
+                // Buffer empty: spin briefly (bursts arrive back-to-back), then park
+                if (EventCount::spinUntil([this]
+                                          { return hasWork(); }))
+                {
+                    continue;
+                }
+
+                const uint32_t key = wakeup_.prepareWait();
+                if (hasWork())
                 {
-                    // Buffer empty, yield CPU
-                    std::this_thread::yield();
+                    wakeup_.cancelWait();
+                    continue;
                 }
+                wakeup_.commitWait(key);
             }
         }
 
-    public:
-        StreamProcessor(size_t pool_initial, size_t pool_max)
-            : object_pool_(pool_initial, pool_max)
+        /**
+         * Schedule a drain task unless one is already queued or running
+         */
+        void scheduleDrain()
         {
+            // Pairs with the fence in drain(): either we see the flag cleared,
+            // or the finishing drain task sees the item we just pushed
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (drainScheduled_.load(std::memory_order_relaxed) ||
+                drainScheduled_.exchange(true, std::memory_order_acq_rel))
+            {
+                return;
+            }
+            enqueueDrain();
         }
 
-        ~StreamProcessor()
+        void enqueueDrain()
         {
-            stop();
+            drainsInFlight_.fetch_add(1, std::memory_order_relaxed);
+            if (!pool_->enqueue([this]
+                                { drain(); }))
+            {
+                // Pool stopping: the task will never run, so stop() must not wait for it
+                drainScheduled_.store(false, std::memory_order_release);
+                drainsInFlight_.fetch_sub(1, std::memory_order_release);
+            }
         }
 
         /**
-         * Start processing
+         * Shared mode: drain up to DRAIN_BUDGET items on a pool worker
          */
-        void start(Callback callback)
+        void drain()
+        {
+            if (running_.load(std::memory_order_acquire))
+            {
+                dispatchBatch();
+            }
+
+            drainScheduled_.store(false, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            // Budget exhausted or item raced in after the last pop: requeue behind other streams
+            if (running_.load(std::memory_order_acquire) && !ring_buffer_.empty() &&
+                !drainScheduled_.exchange(true, std::memory_order_acq_rel))
+            {
+                enqueueDrain();
+            }
+
+            // Last access to this processor from the pool worker
+            drainsInFlight_.fetch_sub(1, std::memory_order_release);
+        }
+
+        void startInternal(Callback callback, BatchCallback batchCallback, ThreadPool *pool)
         {
             if (running_.load(std::memory_order_acquire))
             {
                 return;
             }
 
-            callback_ = callback;
+            callback_ = std::move(callback);
+            batchCallback_ = std::move(batchCallback);
+            if (!batch_)
+            {
+                batch_ = std::make_unique<DataType[]>(DRAIN_BUDGET);
+            }
+            pool_ = pool;
             running_.store(true, std::memory_order_release);
-            worker_thread_ = std::thread(&StreamProcessor::workerLoop, this);
+
+            if (pool_ == nullptr)
+            {
+                worker_thread_ = std::thread(&StreamProcessor::workerLoop, this);
+            }
+            else if (!ring_buffer_.empty())
+            {
+                // Items pushed before start
+                scheduleDrain();
+            }
+        }
+
+    public:
+        StreamProcessor() = default;
+
+        ~StreamProcessor()
+        {
+            stop();
+        }
+
+        /**
+         * Start processing on a dedicated worker thread
+         */
+        void start(Callback callback)
+        {
+            startInternal(std::move(callback), nullptr, nullptr);
+        }
+
+        void start(BatchCallback callback)
+        {
+            startInternal(nullptr, std::move(callback), nullptr);
+        }
+
+        /**
+         * Start processing on a shared thread pool (no dedicated thread)
+         * Pool must outlive this processor or stop() must be called first
+         */
+        void start(Callback callback, ThreadPool &pool)
+        {
+            startInternal(std::move(callback), nullptr, &pool);
+        }
+
+        void start(BatchCallback callback, ThreadPool &pool)
+        {
+            startInternal(nullptr, std::move(callback), &pool);
         }
 
         /**
@@ -87,61 +243,80 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
             }
 
             running_.store(false, std::memory_order_release);
+            wakeup_.notifyAll();
             if (worker_thread_.joinable())
             {
                 worker_thread_.join();
             }
+
+            // Shared mode: wait for queued/running drain tasks (they exit early once running_ is false)
+            while (drainsInFlight_.load(std::memory_order_acquire) != 0)
+            {
+                std::this_thread::yield();
+            }
         }
 
         /**
-         * Push message to ring buffer
+         * Parse message into the ring's producer-private staging item
+         * The item is only published (one copy into its slot) if parsing succeeds
          */
         bool push(const std::string &json)
         {
-            DataType *data = object_pool_.acquire();
-            if (data == nullptr)
+            DataType *staged = ring_buffer_.claim();
+
+            // Staging item still holds the previous message: reset what the parser may not overwrite
+            if constexpr (std::is_same_v<DataType, DepthData>)
             {
-                return false; // Pool exhausted
+                staged->reset(); // Scalars only, not the ~3.2KB of level arrays
+            }
+            else
+            {
+                *staged = DataType();
             }
 
-            // Parse JSON into data
             bool parsed = false;
             if constexpr (std::is_same_v<DataType, DepthData>)
             {
-                parsed = SimdjsonParser::parseDepth(json, *data);
+                parsed = SimdjsonParser::parseDepth(json, *staged);
             }
             else if constexpr (std::is_same_v<DataType, TradeData>)
             {
-                parsed = SimdjsonParser::parseTrade(json, *data);
+                parsed = SimdjsonParser::parseTrade(json, *staged);
             }
             else if constexpr (std::is_same_v<DataType, TickerData>)
             {
-                parsed = SimdjsonParser::parseTicker(json, *data);
+                parsed = SimdjsonParser::parseTicker(json, *staged);
             }
             else if constexpr (std::is_same_v<DataType, MiniTickerData>)
             {
-                parsed = SimdjsonParser::parseMiniTicker(json, *data);
+                parsed = SimdjsonParser::parseMiniTicker(json, *staged);
             }
             else if constexpr (std::is_same_v<DataType, KlineData>)
             {
-                parsed = SimdjsonParser::parseKline(json, *data);
+                parsed = SimdjsonParser::parseKline(json, *staged);
             }
             else if constexpr (std::is_same_v<DataType, UserData>)
             {
-                parsed = SimdjsonParser::parseUserData(json, *data);
+                parsed = SimdjsonParser::parseUserData(json, *staged);
             }
 
             if (!parsed)
             {
-                object_pool_.release(data);
-                return false;
+                return false; // Not published, staging item reused by the next push
             }
 
-            // Push to ring buffer (will overwrite if full)
-            bool overwrote = ring_buffer_.push(*data);
+            // Publish item (overwrites oldest if full; consumer counts it as lost)
+            ring_buffer_.commit();
 
-            // Release back to pool after push (data is copied)
-            object_pool_.release(data);
+            if (pool_ != nullptr)
+            {
+                scheduleDrain();
+            }
+            else
+            {
+                // Wake worker only if it is parked (single load otherwise)
+                wakeup_.notifyOne();
+            }
 
             return true;
         }
@@ -152,18 +327,11 @@ namespace margelo::nitro::cxpmobile_tpsdk::core
         size_t getRingBufferSize() const { return ring_buffer_.size(); }
         uint64_t getPushCount() const { return ring_buffer_.getPushCount(); }
         uint64_t getPopCount() const { return ring_buffer_.getPopCount(); }
-        uint64_t getOverwriteCount() const { return ring_buffer_.getOverwriteCount(); }
-
-        /**
-         * Get object pool statistics
-         */
-        size_t getPoolSize() const { return object_pool_.size(); }
-        size_t getPoolAvailable() const { return object_pool_.available(); }
-        size_t getPoolActive() const { return object_pool_.active(); }
+        uint64_t getLostCount() const { return ring_buffer_.getLostCount(); }
     };
 
     // Type aliases for each stream
-    using DepthProcessor = StreamProcessor<DepthData, 4096>;
+    using DepthProcessor = StreamProcessor<DepthData, 1024>; // DepthData carries MAX_DEPTH_LEVELS per side
     using TradeProcessor = StreamProcessor<TradeData, 2048>;
     using TickerProcessor = StreamProcessor<TickerData, 1024>;
     using MiniTickerProcessor = StreamProcessor<MiniTickerData, 1024>;
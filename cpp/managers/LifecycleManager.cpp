@@ -35,16 +35,22 @@ namespace margelo::nitro::cxpmobile_tpsdk
                 // Note: Cannot copy structs directly because they contain std::mutex (non-copyable)
                 // Must copy data members manually, excluding mutex
                 {
-                    // OrderBook state is now handled in RN store, no copying needed
+                    std::lock_guard<std::mutex> oldLock(oldInstance->orderBookState_.mutex);
+                    std::lock_guard<std::mutex> newLock(newInstance->orderBookState_.mutex);
+                    // Copy all data members except mutex
+                    newInstance->orderBookState_.books = oldInstance->orderBookState_.books;
+                    newInstance->orderBookState_.aggregations = oldInstance->orderBookState_.aggregations;
+                    newInstance->orderBookState_.maxRows = oldInstance->orderBookState_.maxRows;
+                    newInstance->orderBookState_.depthLimit = oldInstance->orderBookState_.depthLimit;
                 }
 
                 {
                     std::lock_guard<std::mutex> oldLock(oldInstance->tradesState_.mutex);
                     std::lock_guard<std::mutex> newLock(newInstance->tradesState_.mutex);
-                    // Copy all data members except mutex
-                    newInstance->tradesState_.queue = oldInstance->tradesState_.queue;
-                    newInstance->tradesState_.maxRows = oldInstance->tradesState_.maxRows;
-                    // mutex is not copied - new instance has its own mutex
+                    // Trades still waiting for their batch flush
+                    newInstance->tradesState_.pendingTrades = oldInstance->tradesState_.pendingTrades;
+                    newInstance->tradesState_.pendingCount = oldInstance->tradesState_.pendingCount;
+                    newInstance->tradesState_.firstPendingTime = oldInstance->tradesState_.firstPendingTime;
                 }
 
                 {
@@ -69,6 +75,12 @@ namespace margelo::nitro::cxpmobile_tpsdk
                     newInstance->orderBookCallback_ = oldInstance->orderBookCallback_;
                 }
 
+                {
+                    std::lock_guard<std::mutex> oldLock(oldInstance->orderBookDiffCallbackMutex_);
+                    std::lock_guard<std::mutex> newLock(newInstance->orderBookDiffCallbackMutex_);
+                    newInstance->orderBookDiffCallback_ = oldInstance->orderBookDiffCallback_;
+                }
+
                 // Trading pair management removed - app manages trading pairs
 
                 {
@@ -100,6 +112,13 @@ namespace margelo::nitro::cxpmobile_tpsdk
                     std::lock_guard<std::mutex> newLock(newInstance->userDataCallbackMutex_);
                     newInstance->userDataCallback_ = oldInstance->userDataCallback_;
                 }
+
+                {
+                    std::lock_guard<std::mutex> oldLock(oldInstance->pushDeliveryMutex_);
+                    std::lock_guard<std::mutex> newLock(newInstance->pushDeliveryMutex_);
+                    newInstance->pushDeliveryCallback_ = oldInstance->pushDeliveryCallback_;
+                    newInstance->pushDeliveryEnabled_.store(oldInstance->pushDeliveryEnabled_.load());
+                }
             }
             catch (const std::system_error &e)
             {
@@ -126,7 +145,8 @@ namespace margelo::nitro::cxpmobile_tpsdk
             {
                 // Clear all data in old instance
                 {
-                    // OrderBook state is now handled in RN store, no cleanup needed
+                    std::lock_guard<std::mutex> lock(oldInstance->orderBookState_.mutex);
+                    oldInstance->orderBookState_.clear();
                 }
 
                 {
@@ -152,6 +172,11 @@ namespace margelo::nitro::cxpmobile_tpsdk
                     oldInstance->orderBookCallback_ = nullptr;
                 }
 
+                {
+                    std::lock_guard<std::mutex> lock(oldInstance->orderBookDiffCallbackMutex_);
+                    oldInstance->orderBookDiffCallback_ = nullptr;
+                }
+
                 {
                     std::lock_guard<std::mutex> lock(oldInstance->tradesCallbackMutex_);
                     oldInstance->tradesCallback_ = nullptr;
@@ -176,6 +201,12 @@ namespace margelo::nitro::cxpmobile_tpsdk
                     std::lock_guard<std::mutex> lock(oldInstance->userDataCallbackMutex_);
                     oldInstance->userDataCallback_ = nullptr;
                 }
+
+                {
+                    oldInstance->pushDeliveryEnabled_.store(false);
+                    std::lock_guard<std::mutex> lock(oldInstance->pushDeliveryMutex_);
+                    oldInstance->pushDeliveryCallback_ = nullptr;
+                }
             }
             catch (const std::system_error &e)
             {
@@ -1,11 +1,42 @@
 #include "OrderBookManager.hpp"
 #include "../TpSdkCppHybrid.hpp"
+#include <algorithm>
 #include <iostream>
 
 namespace margelo::nitro::cxpmobile_tpsdk
 {
     namespace OrderBookManager
     {
+        namespace
+        {
+            /**
+             * Current view of a synced book in its selected grouping (caller holds orderBookState_.mutex)
+             */
+            OrderBookMessageData convertCurrentBook(TpSdkCppHybrid *instance, std::string_view symbol, const core::OrderBookSync &sync)
+            {
+                // Metadata for the converted book (no event time outside the stream)
+                core::DepthData latest;
+                core::JsonExtract::copyToFixedBuffer(symbol, latest.symbol, sizeof(latest.symbol), latest.symbolLen);
+                latest.isSnapshot = true;
+                latest.lastUpdateId = sync.book().lastUpdateId();
+
+                const TpSdkCppHybrid::OrderBookState &state = instance->orderBookState_;
+                OrderBookMessageData result = core::DataConverter::convertOrderBook(latest, sync.book(), static_cast<size_t>(state.maxRows),
+                                                                                    state.aggregationFor(symbol).selected);
+                result.data.synced = sync.isSynced();
+                return result;
+            }
+
+            /**
+             * Aggregation config of symbol, created from the defaults (caller holds orderBookState_.mutex)
+             */
+            TpSdkCppHybrid::OrderBookState::AggregationConfig &aggregationConfig(TpSdkCppHybrid *instance, const std::string &symbol)
+            {
+                TpSdkCppHybrid::OrderBookState &state = instance->orderBookState_;
+                return state.aggregations.try_emplace(symbol, state.defaultAggregation).first->second;
+            }
+        }
+
         void orderbookSubscribe(TpSdkCppHybrid *instance, const std::function<void(const OrderBookMessageData &)> &callback)
         {
             if (instance == nullptr)
@@ -31,6 +62,290 @@ namespace margelo::nitro::cxpmobile_tpsdk
                 std::lock_guard<std::mutex> lock(instance->orderBookCallbackMutex_);
                 instance->orderBookCallback_ = nullptr;
             }
+
+            // Drop the native books (rebuilt from the next snapshot/deltas) unless diff mode still uses them
+            {
+                std::lock_guard<std::mutex> diffLock(instance->orderBookDiffCallbackMutex_);
+                if (instance->orderBookDiffCallback_)
+                {
+                    return;
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(instance->orderBookState_.mutex);
+                instance->orderBookState_.clear();
+            }
+        }
+
+        void orderbookDiffSubscribe(TpSdkCppHybrid *instance, const std::function<void(const OrderBookDiffMessageData &)> &callback)
+        {
+            if (instance == nullptr)
+            {
+                std::cerr << "[OrderBookManager] orderbookDiffSubscribe: instance is null" << std::endl;
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(instance->orderBookDiffCallbackMutex_);
+                instance->orderBookDiffCallback_ = callback;
+            }
+
+            // A new subscriber has no view yet: every symbol starts with a keyframe
+            std::lock_guard<std::mutex> lock(TpSdkCppHybrid::orderBookDiffState_.mutex);
+            TpSdkCppHybrid::orderBookDiffState_.clear();
+        }
+
+        void orderbookDiffUnsubscribe(TpSdkCppHybrid *instance)
+        {
+            if (instance == nullptr)
+            {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(instance->orderBookDiffCallbackMutex_);
+                instance->orderBookDiffCallback_ = nullptr;
+            }
+            {
+                std::lock_guard<std::mutex> lock(TpSdkCppHybrid::orderBookDiffState_.mutex);
+                TpSdkCppHybrid::orderBookDiffState_.clear();
+            }
+
+            // Same as orderbookUnsubscribe: books are dropped once nobody receives them
+            {
+                std::lock_guard<std::mutex> lock(instance->orderBookCallbackMutex_);
+                if (instance->orderBookCallback_)
+                {
+                    return;
+                }
+            }
+            std::lock_guard<std::mutex> lock(instance->orderBookState_.mutex);
+            instance->orderBookState_.clear();
+        }
+
+        void orderbookResyncSubscribe(TpSdkCppHybrid *instance, const std::function<void(const std::string &)> &callback)
+        {
+            if (instance == nullptr)
+            {
+                std::cerr << "[OrderBookManager] orderbookResyncSubscribe: instance is null" << std::endl;
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(instance->orderBookResyncCallbackMutex_);
+            instance->orderBookResyncCallback_ = callback;
+        }
+
+        void orderbookResyncUnsubscribe(TpSdkCppHybrid *instance)
+        {
+            if (instance == nullptr)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(instance->orderBookResyncCallbackMutex_);
+            instance->orderBookResyncCallback_ = nullptr;
+        }
+
+        void resyncAllOrderBooks(TpSdkCppHybrid *instance)
+        {
+            if (instance == nullptr)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(instance->orderBookState_.mutex);
+            for (auto &entry : instance->orderBookState_.books)
+            {
+                entry.second.invalidate();
+            }
+        }
+
+        void loadOrderBookSnapshot(TpSdkCppHybrid *instance, const std::string &symbol, const std::string &snapshotJson)
+        {
+            if (instance == nullptr)
+            {
+                std::cerr << "[OrderBookManager] loadOrderBookSnapshot: instance is null" << std::endl;
+                return;
+            }
+
+            try
+            {
+                // REST snapshots carry no symbol: take it from the caller
+                core::DepthSnapshotData snapshot;
+                core::JsonExtract::copyToFixedBuffer(symbol, snapshot.symbol, sizeof(snapshot.symbol), snapshot.symbolLen);
+                if (!core::SimdjsonParser::parseDepthSnapshot(snapshotJson, snapshot))
+                {
+                    std::cerr << "[OrderBookManager] loadOrderBookSnapshot: invalid snapshot for " << symbol << std::endl;
+                    return;
+                }
+
+                std::vector<OrderBookMessageData> orderBookBatch;
+                core::OrderBookSync::Result result;
+                {
+                    const std::string_view bookSymbol(snapshot.symbol, snapshot.symbolLen);
+                    std::lock_guard<std::mutex> lock(instance->orderBookState_.mutex);
+                    core::OrderBookSync &sync = instance->orderBookState_.book(bookSymbol);
+                    result = sync.onSnapshot(snapshot);
+                    if (result == core::OrderBookSync::Result::APPLIED)
+                    {
+                        orderBookBatch.push_back(convertCurrentBook(instance, bookSymbol, sync));
+                    }
+                }
+
+                if (result == core::OrderBookSync::Result::RESYNC_NEEDED)
+                {
+                    // Buffered deltas start after this snapshot: a newer one is needed
+                    TpSdkCppHybrid::queueOrderBookResyncCallback(symbol, instance);
+                }
+                else
+                {
+                    TpSdkCppHybrid::queueOrderBookCallback(std::move(orderBookBatch), instance);
+                }
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "[C++ ERROR] Exception loading order book snapshot: " << e.what() << std::endl;
+            }
+        }
+
+        void requestOrderBookKeyframe(TpSdkCppHybrid *instance, const std::string &symbol)
+        {
+            if (instance == nullptr)
+            {
+                std::cerr << "[OrderBookManager] requestOrderBookKeyframe: instance is null" << std::endl;
+                return;
+            }
+
+            try
+            {
+                {
+                    std::lock_guard<std::mutex> lock(TpSdkCppHybrid::orderBookDiffState_.mutex);
+                    TpSdkCppHybrid::orderBookDiffState_.view(symbol).requestKeyframe();
+                }
+
+                // Send the keyframe now instead of waiting for the next delta
+                std::vector<OrderBookMessageData> orderBookBatch;
+                {
+                    TpSdkCppHybrid::OrderBookState &state = instance->orderBookState_;
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    auto it = state.books.find(symbol);
+                    if (it != state.books.end() && it->second.isSynced())
+                    {
+                        orderBookBatch.push_back(convertCurrentBook(instance, symbol, it->second));
+                    }
+                }
+
+                if (!orderBookBatch.empty())
+                {
+                    TpSdkCppHybrid::queueOrderBookCallback(std::move(orderBookBatch), instance);
+                }
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "[C++ ERROR] Exception requesting order book keyframe: " << e.what() << std::endl;
+            }
+        }
+
+        void setOrderBookAggregation(TpSdkCppHybrid *instance, const std::string &symbol, const std::string &aggregation)
+        {
+            if (instance == nullptr)
+            {
+                std::cerr << "[OrderBookManager] setOrderBookAggregation: instance is null" << std::endl;
+                return;
+            }
+
+            try
+            {
+                core::Decimal tick; // Empty = raw levels
+                if (!aggregation.empty() && (!core::Decimal::parse(aggregation, tick) || !tick.isPositive()))
+                {
+                    std::cerr << "[OrderBookManager] setOrderBookAggregation: invalid aggregation " << aggregation << std::endl;
+                    return;
+                }
+
+                std::vector<OrderBookMessageData> orderBookBatch;
+                {
+                    TpSdkCppHybrid::OrderBookState &state = instance->orderBookState_;
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    TpSdkCppHybrid::OrderBookState::AggregationConfig &config = aggregationConfig(instance, symbol);
+                    config.selected = tick;
+
+                    const bool maintained = tick.isZero() ||
+                                            std::find(config.levels.begin(), config.levels.end(), tick) != config.levels.end();
+                    if (!maintained)
+                    {
+                        config.levels.push_back(tick);
+                    }
+
+                    auto it = state.books.find(symbol);
+                    if (it != state.books.end())
+                    {
+                        if (!maintained)
+                        {
+                            it->second.setAggregations(config.levels);
+                        }
+                        if (it->second.isSynced())
+                        {
+                            // Ladder is already up to date: the new grouping shows without waiting for a delta
+                            orderBookBatch.push_back(convertCurrentBook(instance, symbol, it->second));
+                        }
+                    }
+                }
+
+                if (!orderBookBatch.empty())
+                {
+                    TpSdkCppHybrid::queueOrderBookCallback(std::move(orderBookBatch), instance);
+                }
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "[C++ ERROR] Exception setting order book aggregation: " << e.what() << std::endl;
+            }
+        }
+
+        void setOrderBookAggregationLevels(TpSdkCppHybrid *instance, const std::string &symbol, const std::vector<std::string> &aggregations)
+        {
+            if (instance == nullptr)
+            {
+                std::cerr << "[OrderBookManager] setOrderBookAggregationLevels: instance is null" << std::endl;
+                return;
+            }
+
+            try
+            {
+                std::vector<core::Decimal> levels;
+                levels.reserve(aggregations.size());
+                for (const std::string &aggregation : aggregations)
+                {
+                    core::Decimal tick;
+                    if (!core::Decimal::parse(aggregation, tick) || !tick.isPositive())
+                    {
+                        std::cerr << "[OrderBookManager] setOrderBookAggregationLevels: invalid aggregation " << aggregation << std::endl;
+                        return;
+                    }
+                    levels.push_back(tick);
+                }
+
+                TpSdkCppHybrid::OrderBookState &state = instance->orderBookState_;
+                std::lock_guard<std::mutex> lock(state.mutex);
+                TpSdkCppHybrid::OrderBookState::AggregationConfig &config = aggregationConfig(instance, symbol);
+                // The selected grouping stays maintained
+                if (config.selected.isPositive() && std::find(levels.begin(), levels.end(), config.selected) == levels.end())
+                {
+                    levels.push_back(config.selected);
+                }
+                config.levels = std::move(levels);
+
+                auto it = state.books.find(symbol);
+                if (it != state.books.end())
+                {
+                    it->second.setAggregations(config.levels);
+                }
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "[C++ ERROR] Exception setting order book aggregation levels: " << e.what() << std::endl;
+            }
         }
     }
 }
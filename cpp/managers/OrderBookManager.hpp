@@ -2,7 +2,9 @@
 
 #include <string>
 #include <functional>
+#include <vector>
 #include "../../nitrogen/generated/shared/c++/OrderBookMessageData.hpp"
+#include "../../nitrogen/generated/shared/c++/OrderBookDiffMessageData.hpp"
 
 namespace margelo::nitro::cxpmobile_tpsdk
 {
@@ -10,8 +12,26 @@ namespace margelo::nitro::cxpmobile_tpsdk
 
     namespace OrderBookManager
     {
-        // Callback management only (state handled in RN store)
+        // Callback management (books live in TpSdkCppHybrid::orderBookState_)
         void orderbookSubscribe(TpSdkCppHybrid *instance, const std::function<void(const OrderBookMessageData &)> &callback);
         void orderbookUnsubscribe(TpSdkCppHybrid *instance);
+        void orderbookResyncSubscribe(TpSdkCppHybrid *instance, const std::function<void(const std::string &)> &callback);
+        void orderbookResyncUnsubscribe(TpSdkCppHybrid *instance);
+        void orderbookDiffSubscribe(TpSdkCppHybrid *instance, const std::function<void(const OrderBookDiffMessageData &)> &callback);
+        void orderbookDiffUnsubscribe(TpSdkCppHybrid *instance);
+
+        // Next diff patch for symbol is a keyframe, sent with its current book
+        void requestOrderBookKeyframe(TpSdkCppHybrid *instance, const std::string &symbol);
+
+        // Frames were lost before parsing: every book waits for a snapshot (resync reported on its next delta)
+        void resyncAllOrderBooks(TpSdkCppHybrid *instance);
+
+        // Sync symbol's book from a REST depth snapshot and replay buffered deltas
+        void loadOrderBookSnapshot(TpSdkCppHybrid *instance, const std::string &symbol, const std::string &snapshotJson);
+
+        // Select the grouping sent for symbol ("" = raw levels) and re-send its current book
+        void setOrderBookAggregation(TpSdkCppHybrid *instance, const std::string &symbol, const std::string &aggregation);
+        // Tick sizes whose ladders symbol's book keeps up to date
+        void setOrderBookAggregationLevels(TpSdkCppHybrid *instance, const std::string &symbol, const std::vector<std::string> &aggregations);
     }
 }
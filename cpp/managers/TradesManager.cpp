@@ -26,13 +26,10 @@ namespace margelo::nitro::cxpmobile_tpsdk
                     instance->tradesCallback_ = nullptr;
                 }
 
-                // Clear all trades data (pendingTrades and queue)
+                // Clear all trades data (pending batch, burst state and queue; resets flush time)
                 {
                     std::lock_guard<std::mutex> lock(instance->tradesState_.mutex);
-                    instance->tradesState_.pendingTrades.clear();
-                    instance->tradesState_.queue.clear();
-                    // Reset flush time
-                    instance->tradesState_.lastFlushTime = std::chrono::steady_clock::now();
+                    instance->tradesState_.clear();
                 }
             }
         }
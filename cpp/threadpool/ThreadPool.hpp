@@ -1,33 +1,342 @@
 #pragma once
 
+#include "../core/EventCount.hpp"
 #include <vector>
+#include <deque>
 #include <thread>
-#include <queue>
 #include <mutex>
-#include <condition_variable>
 #include <functional>
 #include <atomic>
 #include <algorithm>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <cstddef>
+#include <cstdint>
 
 namespace margelo::nitro::cxpmobile_tpsdk
 {
     /**
-     * Thread Pool with work-stealing support
-     * 
+     * Small-buffer move-only task
+     *
+     * Callables up to INLINE_SIZE bytes (e.g. a lambda capturing `this` or a
+     * shared_ptr) are stored inline - no heap allocation per task, unlike
+     * std::function. Larger callables fall back to one heap allocation.
+     */
+    class Task
+    {
+    public:
+        static constexpr size_t INLINE_SIZE = 48;
+
+    private:
+        enum class Op
+        {
+            MOVE,
+            DESTROY
+        };
+
+        alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE];
+        void (*invoke_)(void *) = nullptr;
+        void (*manage_)(Op, void *, void *) = nullptr;
+
+        template <typename F>
+        static constexpr bool fitsInline()
+        {
+            return sizeof(F) <= INLINE_SIZE && alignof(F) <= alignof(std::max_align_t) &&
+                   std::is_nothrow_move_constructible_v<F>;
+        }
+
+        template <typename F>
+        static void invokeInline(void *storage)
+        {
+            (*static_cast<F *>(storage))();
+        }
+
+        template <typename F>
+        static void manageInline(Op op, void *dst, void *src)
+        {
+            if (op == Op::MOVE)
+            {
+                new (dst) F(std::move(*static_cast<F *>(src)));
+            }
+            static_cast<F *>(src)->~F();
+        }
+
+        template <typename F>
+        static void invokeHeap(void *storage)
+        {
+            (**static_cast<F **>(storage))();
+        }
+
+        template <typename F>
+        static void manageHeap(Op op, void *dst, void *src)
+        {
+            if (op == Op::MOVE)
+            {
+                *static_cast<F **>(dst) = *static_cast<F **>(src);
+            }
+            else
+            {
+                delete *static_cast<F **>(src);
+            }
+        }
+
+    public:
+        Task() = default;
+
+        template <typename F, typename Fn = std::decay_t<F>,
+                  typename = std::enable_if_t<!std::is_same_v<Fn, Task> && std::is_invocable_v<Fn &>>>
+        Task(F &&fn)
+        {
+            if constexpr (fitsInline<Fn>())
+            {
+                new (storage_) Fn(std::forward<F>(fn));
+                invoke_ = &invokeInline<Fn>;
+                manage_ = &manageInline<Fn>;
+            }
+            else
+            {
+                *reinterpret_cast<Fn **>(storage_) = new Fn(std::forward<F>(fn));
+                invoke_ = &invokeHeap<Fn>;
+                manage_ = &manageHeap<Fn>;
+            }
+        }
+
+        Task(Task &&other) noexcept
+        {
+            if (other.manage_ != nullptr)
+            {
+                other.manage_(Op::MOVE, storage_, other.storage_);
+                invoke_ = other.invoke_;
+                manage_ = other.manage_;
+                other.invoke_ = nullptr;
+                other.manage_ = nullptr;
+            }
+        }
+
+        Task &operator=(Task &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                if (other.manage_ != nullptr)
+                {
+                    other.manage_(Op::MOVE, storage_, other.storage_);
+                    invoke_ = other.invoke_;
+                    manage_ = other.manage_;
+                    other.invoke_ = nullptr;
+                    other.manage_ = nullptr;
+                }
+            }
+            return *this;
+        }
+
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+
+        ~Task()
+        {
+            reset();
+        }
+
+        void reset()
+        {
+            if (manage_ != nullptr)
+            {
+                manage_(Op::DESTROY, nullptr, storage_);
+                invoke_ = nullptr;
+                manage_ = nullptr;
+            }
+        }
+
+        explicit operator bool() const { return invoke_ != nullptr; }
+
+        void operator()() { invoke_(storage_); }
+    };
+
+    /**
+     * Thread Pool with work-stealing
+     *
      * Auto-detects CPU cores (min 2, max 4)
-     * Supports work-stealing for better load balancing
+     *
+     * Features:
+     * - Per-worker lock-free Chase-Lev deque: owner pushes/pops LIFO at the bottom,
+     *   idle workers steal FIFO from the top of a random victim
+     * - Tasks submitted from outside the pool go through a shared injection queue
+     * - Task nodes are recycled per worker (no allocation in steady state)
+     * - Idle workers spin briefly, then park on an EventCount
      */
     class ThreadPool
     {
     private:
-        std::vector<std::thread> workers_;
-        std::queue<std::function<void()>> tasks_;
-        std::mutex queue_mutex_;
-        std::condition_variable condition_;
+        struct Worker;
+
+        struct TaskNode
+        {
+            Task task;
+            TaskNode *next = nullptr; // Free-list link
+            Worker *owner = nullptr;
+        };
+
+        /**
+         * Bounded Chase-Lev work-stealing deque (Le et al. 2013 memory orderings)
+         * Owner: push()/pop() at bottom. Thieves: steal() at top.
+         */
+        class WorkStealingDeque
+        {
+        public:
+            static constexpr int64_t CAPACITY = 1024;
+
+        private:
+            alignas(64) std::atomic<int64_t> top_{0};
+            alignas(64) std::atomic<int64_t> bottom_{0};
+            std::atomic<TaskNode *> buffer_[CAPACITY];
+
+        public:
+            WorkStealingDeque()
+            {
+                for (auto &slot : buffer_)
+                {
+                    slot.store(nullptr, std::memory_order_relaxed);
+                }
+            }
+
+            // Owner only. Returns false when full (caller falls back to the injection queue)
+            bool push(TaskNode *node)
+            {
+                const int64_t b = bottom_.load(std::memory_order_relaxed);
+                const int64_t t = top_.load(std::memory_order_acquire);
+                if (b - t >= CAPACITY)
+                {
+                    return false;
+                }
+                buffer_[b & (CAPACITY - 1)].store(node, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                return true;
+            }
+
+            // Owner only
+            TaskNode *pop()
+            {
+                const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+                bottom_.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64_t t = top_.load(std::memory_order_relaxed);
+
+                if (t > b)
+                {
+                    // Empty
+                    bottom_.store(b + 1, std::memory_order_relaxed);
+                    return nullptr;
+                }
+
+                TaskNode *node = buffer_[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+                if (t == b)
+                {
+                    // Last item: race against thieves
+                    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    {
+                        node = nullptr;
+                    }
+                    bottom_.store(b + 1, std::memory_order_relaxed);
+                }
+                return node;
+            }
+
+            // Any thread
+            TaskNode *steal()
+            {
+                int64_t t = top_.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const int64_t b = bottom_.load(std::memory_order_acquire);
+                if (t >= b)
+                {
+                    return nullptr;
+                }
+
+                TaskNode *node = buffer_[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+                if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    return nullptr; // Lost race with owner or another thief
+                }
+                return node;
+            }
+
+            bool empty() const
+            {
+                return bottom_.load(std::memory_order_acquire) <= top_.load(std::memory_order_acquire);
+            }
+        };
+
+        struct Worker
+        {
+            WorkStealingDeque deque;
+            std::thread thread;
+            uint64_t rngState = 0;
+
+            // Node recycling: owner-only free list + lock-free return stack for remote frees
+            TaskNode *freeList = nullptr;
+            alignas(64) std::atomic<TaskNode *> remoteFree{nullptr};
+            std::vector<std::unique_ptr<TaskNode[]>> nodeChunks;
+
+            static constexpr size_t NODE_CHUNK_SIZE = 64;
+
+            TaskNode *allocNode()
+            {
+                if (freeList == nullptr)
+                {
+                    // Reclaim nodes freed by thieves (single consumer: exchange, no ABA)
+                    freeList = remoteFree.exchange(nullptr, std::memory_order_acquire);
+                }
+                if (freeList == nullptr)
+                {
+                    auto chunk = std::make_unique<TaskNode[]>(NODE_CHUNK_SIZE);
+                    for (size_t i = 0; i < NODE_CHUNK_SIZE; ++i)
+                    {
+                        chunk[i].owner = this;
+                        chunk[i].next = freeList;
+                        freeList = &chunk[i];
+                    }
+                    nodeChunks.push_back(std::move(chunk));
+                }
+                TaskNode *node = freeList;
+                freeList = node->next;
+                return node;
+            }
+
+            void freeNodeLocal(TaskNode *node)
+            {
+                node->next = freeList;
+                freeList = node;
+            }
+
+            void freeNodeRemote(TaskNode *node)
+            {
+                TaskNode *head = remoteFree.load(std::memory_order_relaxed);
+                do
+                {
+                    node->next = head;
+                } while (!remoteFree.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+            }
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers_;
         std::atomic<bool> stop_;
 
+        // Injection queue for tasks submitted from non-pool threads
+        std::deque<Task> injected_;
+        std::mutex injected_mutex_;
+        alignas(64) std::atomic<size_t> injected_count_{0};
+
+        core::EventCount wakeup_;
+
+        // Identifies the pool worker running on the current thread (if any)
+        static inline thread_local Worker *tls_worker_ = nullptr;
+        static inline thread_local ThreadPool *tls_pool_ = nullptr;
+
         /**
          * Auto-detect optimal thread count
          * Returns number between min_threads and max_threads
@@ -51,40 +360,210 @@ namespace margelo::nitro::cxpmobile_tpsdk
             return hardware_threads;
         }
 
+        Worker *currentWorker() const
+        {
+            return tls_pool_ == this ? tls_worker_ : nullptr;
+        }
+
+        static size_t nextRandom(Worker &worker)
+        {
+            // xorshift64
+            uint64_t x = worker.rngState;
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            worker.rngState = x;
+            return static_cast<size_t>(x);
+        }
+
+        bool popInjected(Task &task)
+        {
+            if (injected_count_.load(std::memory_order_acquire) == 0)
+            {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(injected_mutex_);
+            if (injected_.empty())
+            {
+                return false;
+            }
+            task = std::move(injected_.front());
+            injected_.pop_front();
+            injected_count_.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+
+        void pushInjected(Task &&task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(injected_mutex_);
+                injected_.push_back(std::move(task));
+                injected_count_.fetch_add(1, std::memory_order_release);
+            }
+        }
+
+        TaskNode *stealFromOthers(Worker &self)
+        {
+            const size_t count = workers_.size();
+            const size_t start = nextRandom(self) % count;
+            for (size_t i = 0; i < count; ++i)
+            {
+                Worker &victim = *workers_[(start + i) % count];
+                if (&victim == &self)
+                {
+                    continue;
+                }
+                if (TaskNode *node = victim.deque.steal())
+                {
+                    return node;
+                }
+            }
+            return nullptr;
+        }
+
+        bool hasPendingWork() const
+        {
+            if (injected_count_.load(std::memory_order_acquire) != 0)
+            {
+                return true;
+            }
+            for (const auto &worker : workers_)
+            {
+                if (!worker->deque.empty())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static void runTask(Task &task)
+        {
+            try
+            {
+                task();
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "[C++ ERROR] ThreadPool task exception: " << e.what() << std::endl;
+            }
+            catch (...)
+            {
+                std::cerr << "[C++ ERROR] ThreadPool task unknown exception" << std::endl;
+            }
+        }
+
+        void runNode(Worker &self, TaskNode *node)
+        {
+            runTask(node->task);
+            node->task.reset();
+            if (node->owner == &self)
+            {
+                self.freeNodeLocal(node);
+            }
+            else
+            {
+                node->owner->freeNodeRemote(node);
+            }
+        }
+
+        /**
+         * Try to run one task: own deque, injection queue, then steal
+         */
+        bool runOne(Worker &self)
+        {
+            if (TaskNode *node = self.deque.pop())
+            {
+                runNode(self, node);
+                return true;
+            }
+
+            Task task;
+            if (popInjected(task))
+            {
+                runTask(task);
+                return true;
+            }
+
+            if (TaskNode *node = stealFromOthers(self))
+            {
+                runNode(self, node);
+                return true;
+            }
+            return false;
+        }
+
         /**
          * Worker thread function
          */
-        void worker()
+        void worker(Worker *self, size_t index)
         {
+            tls_worker_ = self;
+            tls_pool_ = this;
+            self->rngState = 0x9E3779B97F4A7C15ull * (index + 1);
+
             while (true)
             {
-                std::function<void()> task;
+                if (runOne(*self))
                 {
-                    std::unique_lock<std::mutex> lock(queue_mutex_);
-                    condition_.wait(lock, [this] { return stop_.load() || !tasks_.empty(); });
+                    continue;
+                }
 
-                    if (stop_.load() && tasks_.empty())
+                if (stop_.load(std::memory_order_acquire))
+                {
+                    // Drain remaining work before exiting (same as before)
+                    if (!hasPendingWork())
                     {
-                        return;
+                        break;
                     }
-
-                    task = std::move(tasks_.front());
-                    tasks_.pop();
+                    continue;
                 }
 
-                try
+                // Idle: spin briefly, then park
+                if (core::EventCount::spinUntil([this]
+                                                { return hasPendingWork() || stop_.load(std::memory_order_acquire); }))
                 {
-                    task();
+                    continue;
                 }
-                catch (const std::exception& e)
+
+                const uint32_t key = wakeup_.prepareWait();
+                if (hasPendingWork() || stop_.load(std::memory_order_acquire))
                 {
-                    std::cerr << "[C++ ERROR] ThreadPool task exception: " << e.what() << std::endl;
+                    wakeup_.cancelWait();
+                    continue;
                 }
-                catch (...)
+                wakeup_.commitWait(key);
+            }
+
+            tls_worker_ = nullptr;
+            tls_pool_ = nullptr;
+        }
+
+        /**
+         * Queue task without waking anyone (caller notifies)
+         */
+        bool submit(Task &&task)
+        {
+            if (stop_.load(std::memory_order_acquire))
+            {
+                return false; // Pool is stopped
+            }
+
+            if (Worker *self = currentWorker())
+            {
+                TaskNode *node = self->allocNode();
+                node->task = std::move(task);
+                if (self->deque.push(node))
                 {
-                    std::cerr << "[C++ ERROR] ThreadPool task unknown exception" << std::endl;
+                    return true;
                 }
+                // Deque full: hand the task back and use the injection queue
+                task = std::move(node->task);
+                self->freeNodeLocal(node);
             }
+
+            pushInjected(std::move(task));
+            return true;
         }
 
     public:
@@ -99,29 +578,31 @@ namespace margelo::nitro::cxpmobile_tpsdk
                 thread_count = detectOptimalThreadCount();
             }
 
+            // Create all workers before starting threads (thieves index workers_)
             workers_.reserve(thread_count);
             for (size_t i = 0; i < thread_count; ++i)
             {
-                workers_.emplace_back(&ThreadPool::worker, this);
+                workers_.push_back(std::make_unique<Worker>());
+            }
+            for (size_t i = 0; i < thread_count; ++i)
+            {
+                workers_[i]->thread = std::thread(&ThreadPool::worker, this, workers_[i].get(), i);
             }
         }
 
         /**
-         * Destructor - stops all threads
+         * Destructor - runs remaining tasks, then stops all threads
          */
         ~ThreadPool()
         {
-            {
-                std::lock_guard<std::mutex> lock(queue_mutex_);
-                stop_.store(true);
-            }
-            condition_.notify_all();
+            stop_.store(true, std::memory_order_release);
+            wakeup_.notifyAll();
 
-            for (auto& worker : workers_)
+            for (auto &worker : workers_)
             {
-                if (worker.joinable())
+                if (worker->thread.joinable())
                 {
-                    worker.join();
+                    worker->thread.join();
                 }
             }
         }
@@ -134,18 +615,19 @@ namespace margelo::nitro::cxpmobile_tpsdk
 
         /**
          * Enqueue task to thread pool
+         * From a pool worker: pushed onto its own deque (stealable by idle workers)
+         * From any other thread: pushed onto the shared injection queue
+         * Returns false if the pool is stopping (the task is dropped and never runs)
          */
-        void enqueue(std::function<void()> task)
+        template <typename F>
+        bool enqueue(F &&task)
         {
+            if (!submit(Task(std::forward<F>(task))))
             {
-                std::lock_guard<std::mutex> lock(queue_mutex_);
-                if (stop_.load())
-                {
-                    return;  // Pool is stopped
-                }
-                tasks_.push(std::move(task));
+                return false;
             }
-            condition_.notify_one();
+            wakeup_.notifyOne();
+            return true;
         }
 
         /**
@@ -157,4 +639,3 @@ namespace margelo::nitro::cxpmobile_tpsdk
         }
     };
 }
-
@@ -20,6 +20,22 @@ interface OrderBookScreenProps {
 }
 
 const AGGREGATION_OPTIONS = ['0.01', '0.1', '1', '10', '100'];
+const INITIAL_AGGREGATION = '0.01';
+
+// REST depth snapshot for diff streams: {"lastUpdateId":..,"bids":[..],"asks":[..]}
+// CXP: same host as the WebSocket (update if your REST API lives elsewhere)
+const BINANCE_REST_URL = 'https://api.binance.com';
+
+function depthSnapshotUrl(
+  wsUrl: string,
+  symbol: string,
+  isCXP: boolean
+): string {
+  const baseUrl = isCXP
+    ? wsUrl.replace(/^ws/, 'http').replace(/\/ws$/, '')
+    : BINANCE_REST_URL;
+  return `${baseUrl}/api/v3/depth?symbol=${symbol.toUpperCase()}&limit=1000`;
+}
 
 export function OrderBookScreen({
   binanceBaseUrl,
@@ -27,7 +43,7 @@ export function OrderBookScreen({
 }: OrderBookScreenProps) {
   const displayData = useTradingStore((state) => state.orderBook);
   const setOrderBook = useTradingStore((state) => state.setOrderBook);
-  const [aggregation, setAggregation] = useState('0.01');
+  const [aggregation, setAggregation] = useState(INITIAL_AGGREGATION);
   const subscriptionIdRef = useRef<string | null>(null);
   const wsRef = useRef<WebSocket | null>(null);
   const [isConnected, setIsConnected] = useState(false);
@@ -129,19 +145,16 @@ export function OrderBookScreen({
 
     try {
       const orderbookCallback = (data: OrderBookMessageData) => {
-        // Move heavy calculations (parseFloat, cumulative sums) to UI thread
+        // Cumulative quantities come precomputed from C++ (no per-level parsing here)
         runOnUISync(() => {
           'worklet';
-          // Calculate cumulative quantities for animation background
-          let bidCumulative = 0;
-          let askCumulative = 0;
-          const maxBidCumulative: number[] = [];
-          const maxAskCumulative: number[] = [];
-
-          const bidsRaw = data.data.bids;
-          const asksRaw = data.data.asks;
+          const {
+            bids: bidsRaw,
+            asks: asksRaw,
+            bidCumulative,
+            askCumulative,
+          } = data.data;
 
-          // Process bids - calculate cumulative on UI thread
           const bids: Array<{
             priceStr: string;
             amountStr: string;
@@ -150,18 +163,13 @@ export function OrderBookScreen({
           for (let i = 0; i < bidsRaw.length; i++) {
             const bid = bidsRaw[i];
             if (!bid) continue;
-            const [price, quantity] = bid;
-            const qty = parseFloat(quantity) || 0;
-            bidCumulative += qty;
-            maxBidCumulative.push(bidCumulative);
             bids.push({
-              priceStr: price,
-              amountStr: quantity,
-              cumulativeQuantity: bidCumulative.toString(),
+              priceStr: bid[0],
+              amountStr: bid[1],
+              cumulativeQuantity: String(bidCumulative[i] ?? 0),
             });
           }
 
-          // Process asks - calculate cumulative on UI thread
           const asks: Array<{
             priceStr: string;
             amountStr: string;
@@ -170,34 +178,16 @@ export function OrderBookScreen({
           for (let i = 0; i < asksRaw.length; i++) {
             const ask = asksRaw[i];
             if (!ask) continue;
-            const [price, quantity] = ask;
-            const qty = parseFloat(quantity) || 0;
-            askCumulative += qty;
-            maxAskCumulative.push(askCumulative);
             asks.push({
-              priceStr: price,
-              amountStr: quantity,
-              cumulativeQuantity: askCumulative.toString(),
+              priceStr: ask[0],
+              amountStr: ask[1],
+              cumulativeQuantity: String(askCumulative[i] ?? 0),
             });
           }
 
-          // Find max cumulative quantity for animation scaling
-          let maxBid = 0;
-          for (let i = 0; i < maxBidCumulative.length; i++) {
-            const val = maxBidCumulative[i];
-            if (val !== undefined && val > maxBid) {
-              maxBid = val;
-            }
-          }
-
-          let maxAsk = 0;
-          for (let i = 0; i < maxAskCumulative.length; i++) {
-            const val = maxAskCumulative[i];
-            if (val !== undefined && val > maxAsk) {
-              maxAsk = val;
-            }
-          }
-
+          // Deepest visible row of either side scales the bars
+          const maxBid = bidCumulative[bidCumulative.length - 1] ?? 0;
+          const maxAsk = askCumulative[askCumulative.length - 1] ?? 0;
           const maxCumulative = maxBid > maxAsk ? maxBid : maxAsk;
 
           // Build result object
@@ -234,16 +224,60 @@ export function OrderBookScreen({
     };
   }, [aggregation, setOrderBook]);
 
+  // Diff stream (@depth): the SDK asks for a REST snapshot on the first delta and after a gap
+  useEffect(() => {
+    if (!TpSdk.isInitialized?.()) {
+      return;
+    }
+
+    let active = true;
+    const resyncId = TpSdk.orderbook.subscribeResync((symbol) => {
+      fetch(depthSnapshotUrl(binanceBaseUrl, symbol, isCXP))
+        .then((response) => {
+          if (!response.ok) {
+            throw new Error(`HTTP ${response.status}`);
+          }
+          return response.text();
+        })
+        .then((snapshotJson) => {
+          if (active) {
+            TpSdk.orderbook.loadSnapshot(symbol, snapshotJson);
+          }
+        })
+        .catch((error) => {
+          // Without a resync handler the SDK keeps building the book from deltas (synced: false)
+          console.error('[OrderBookScreen] Snapshot fetch failed:', error);
+          if (active) {
+            active = false;
+            TpSdk.orderbook.unsubscribeResync(resyncId);
+          }
+        });
+    });
+
+    return () => {
+      if (active) {
+        active = false;
+        TpSdk.orderbook.unsubscribeResync(resyncId);
+      }
+    };
+  }, [binanceBaseUrl, isCXP]);
+
+  // The SDK shows raw levels until a grouping is selected
+  useEffect(() => {
+    TpSdk.orderbook.setAggregation(defaultSymbol, INITIAL_AGGREGATION);
+  }, [defaultSymbol]);
+
   // Handle aggregation change
   const handleAggregationChange = useCallback(
     (newAggregation: string) => {
       if (newAggregation === aggregation) {
         return;
       }
-      // Update state - aggregation will be handled in UI if needed
+      // Grouped in C++ (ladders kept up to date per tick): the book is re-sent at once
+      TpSdk.orderbook.setAggregation(defaultSymbol, newAggregation);
       setAggregation(newAggregation);
     },
-    [aggregation]
+    [aggregation, defaultSymbol]
   );
 
   // Reset orderbook
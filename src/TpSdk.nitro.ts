@@ -1,6 +1,7 @@
 import type { HybridObject } from 'react-native-nitro-modules';
 import type {
   KlineMessageData,
+  OrderBookDiffMessageData,
   OrderBookMessageData,
   TickerMessageData,
   TradeMessageData,
@@ -20,17 +21,84 @@ export interface TpSdk extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   processWebSocketMessage(
     messageJson: string
   ): WebSocketMessageResultNitro | null;
-  processCallbackQueue(): void;
+  /**
+   * Run queued callbacks until budgetUs microseconds are spent (at least one runs).
+   * @returns number of callbacks still queued (a trade batch waiting for its
+   * flush timeout counts as one, so callers poll again on the next frame)
+   */
+  processCallbackQueue(budgetUs?: number): number;
+
+  /**
+   * Push-mode delivery: onPending is scheduled on the JS thread once per
+   * coalesced batch of queued callbacks (drain with processCallbackQueue).
+   */
+  enablePushDelivery(onPending: () => void): void;
+  disablePushDelivery(): void;
+
+  /**
+   * Frames dropped before parsing (ingest ring full or frame over 512KB).
+   * Order books resync after a drop (see orderbook subscribeResync).
+   */
+  getDroppedFrameCount(): number;
 
   isInitialized(): boolean;
   markInitialized(callback?: () => void): void;
 
+  // ============================================================================
+  // Symbol Metadata Methods
+  // ============================================================================
+
+  /**
+   * Set display precision for a symbol's prices and quantities.
+   * Pass -1 for shortest round-trip formatting (default for unregistered symbols).
+   */
+  setSymbolPrecision(
+    symbol: string,
+    priceDecimals: number,
+    quantityDecimals: number
+  ): void;
+
   // ============================================================================
   // OrderBook Methods
   // ============================================================================
 
   orderbookSubscribe(callback: (data: OrderBookMessageData) => void): void;
   orderbookUnsubscribe(): void;
+  /**
+   * Diff mode: row-level patches (insert/update/remove by row index) against
+   * the view previously delivered for the symbol, with a periodic keyframe.
+   */
+  orderbookDiffSubscribe(
+    callback: (data: OrderBookDiffMessageData) => void
+  ): void;
+  orderbookDiffUnsubscribe(): void;
+  /**
+   * Next patch for symbol is a keyframe, sent right away (call on a version gap)
+   */
+  requestOrderBookKeyframe(symbol: string): void;
+  /**
+   * Called with the symbol of a book that needs a REST depth snapshot: first
+   * delta seen, or a sequence gap. Answer with loadOrderBookSnapshot.
+   */
+  orderbookResyncSubscribe(callback: (symbol: string) => void): void;
+  orderbookResyncUnsubscribe(): void;
+  /**
+   * Sync symbol's book from a REST depth snapshot
+   * ({"lastUpdateId":...,"bids":[...],"asks":[...]}); deltas buffered since
+   * the resync request are replayed on top of it.
+   */
+  loadOrderBookSnapshot(symbol: string, snapshotJson: string): void;
+  /**
+   * Price grouping of symbol's book rows, e.g. "0.1" ("" = raw levels, the default).
+   * Groupings in the maintained levels switch instantly: the current book is
+   * re-sent right away.
+   */
+  setOrderBookAggregation(symbol: string, aggregation: string): void;
+  /**
+   * Tick sizes whose grouped ladders symbol's book keeps up to date
+   * (default "0.01", "0.1", "1", "10").
+   */
+  setOrderBookAggregationLevels(symbol: string, aggregations: string[]): void;
 
   // ============================================================================
   // Trades Methods
@@ -67,10 +135,12 @@ export interface TpSdk extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
 // Re-exports
 // ============================================================================
 
-export { WebSocketMessageType } from './types';
+export { OrderBookRowOpType, WebSocketMessageType } from './types';
 export type {
   KlineMessageData,
+  OrderBookDiffMessageData,
   OrderBookMessageData,
+  OrderBookRowOp,
   ProtocolMessageDataNitro,
   TickerMessageData,
   TradeMessageData,
@@ -48,13 +48,16 @@ export { userData } from './sdk/modules/userData';
 // ============================================================================
 export type {
   KlineMessageData,
+  OrderBookDiffMessageData,
   OrderBookMessageData,
+  OrderBookRowOp,
   ProtocolMessageDataNitro,
   TickerMessageData,
   TradeMessageData,
   UserMessageData,
   WebSocketMessageType,
 } from './TpSdk.nitro';
+export { OrderBookRowOpType } from './TpSdk.nitro';
 
 // ============================================================================
 // Types (from types/index.ts - TypeScript types with 'any' fields)
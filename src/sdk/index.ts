@@ -1,4 +1,9 @@
-import { processCallbacksThrottled } from '../shared/callbackQueue';
+import {
+  disablePushDelivery,
+  enablePushDelivery,
+  isPushDeliveryEnabled,
+  processCallbacksThrottled,
+} from '../shared/callbackQueue';
 import { TpSdkHybridObject } from '../shared/TpSdkInstance';
 import { kline } from './modules/kline';
 import { orderbook } from './modules/orderbook';
@@ -31,8 +36,22 @@ const parseMessageFunction = (messageJson: string) => {
     messageJson.length
   );
   TpSdkHybridObject.processWebSocketMessage(messageJson);
-  // Automatically process callbacks with throttling
-  processCallbacksThrottled();
+  // Automatically process callbacks with throttling (push mode is notified by C++)
+  if (!isPushDeliveryEnabled()) {
+    processCallbacksThrottled();
+  }
+};
+
+/**
+ * Switch between push-mode delivery (C++ notifies JS as soon as updates are
+ * queued) and the default RAF polling
+ */
+const setPushDeliveryFunction = (enabled: boolean) => {
+  if (enabled) {
+    enablePushDelivery();
+  } else {
+    disablePushDelivery();
+  }
 };
 
 const modules = {
@@ -44,6 +63,7 @@ const modules = {
   userData,
   init: initFunction,
   parseMessage: parseMessageFunction,
+  setPushDelivery: setPushDeliveryFunction,
 };
 
 // Type assertion needed because we're dynamically adding TypeScript modules
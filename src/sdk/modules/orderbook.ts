@@ -1,4 +1,7 @@
-import type { OrderBookMessageData } from '../../TpSdk.nitro';
+import type {
+  OrderBookDiffMessageData,
+  OrderBookMessageData,
+} from '../../TpSdk.nitro';
 import { SubscriptionManager } from '../../shared/SubscriptionManager';
 import { TpSdkHybridObject } from '../../shared/TpSdkInstance';
 import { createModuleValidator } from '../../shared/moduleUtils';
@@ -10,6 +13,16 @@ const subscriptionManager = new SubscriptionManager<OrderBookMessageData>(
   () => TpSdkHybridObject.orderbookUnsubscribe()
 );
 
+const diffSubscriptionManager = new SubscriptionManager<OrderBookDiffMessageData>(
+  (callback) => TpSdkHybridObject.orderbookDiffSubscribe(callback),
+  () => TpSdkHybridObject.orderbookDiffUnsubscribe()
+);
+
+const resyncSubscriptionManager = new SubscriptionManager<string>(
+  (callback) => TpSdkHybridObject.orderbookResyncSubscribe(callback),
+  () => TpSdkHybridObject.orderbookResyncUnsubscribe()
+);
+
 export const orderbook = {
   subscribe: (callback: (data: OrderBookMessageData) => void): string => {
     validateInitialized('subscribe');
@@ -19,6 +32,60 @@ export const orderbook = {
   unsubscribe: (subscriptionId: string): void => {
     subscriptionManager.unsubscribe(subscriptionId);
   },
+
+  /**
+   * Diff mode: patches against the previously delivered view. Ops carry only
+   * rows whose price/quantity changed; cumulative, bar ratio and depth chart
+   * arrays come whole and a missing one is unchanged. Apply ops in order; on
+   * keyframe start from an empty view. A version gap means a patch
+   * was missed: call requestKeyframe(symbol). Subscribers added while diffs
+   * are flowing start from requestKeyframe as well.
+   */
+  subscribeDiff: (
+    callback: (data: OrderBookDiffMessageData) => void
+  ): string => {
+    validateInitialized('subscribeDiff');
+    return diffSubscriptionManager.subscribe(callback);
+  },
+
+  unsubscribeDiff: (subscriptionId: string): void => {
+    diffSubscriptionManager.unsubscribe(subscriptionId);
+  },
+
+  requestKeyframe: (symbol: string): void => {
+    validateInitialized('requestKeyframe');
+    TpSdkHybridObject.requestOrderBookKeyframe(symbol);
+  },
+
+  /**
+   * Called with a symbol whose book needs a REST snapshot (see loadSnapshot)
+   */
+  subscribeResync: (callback: (symbol: string) => void): string => {
+    validateInitialized('subscribeResync');
+    return resyncSubscriptionManager.subscribe(callback);
+  },
+
+  unsubscribeResync: (subscriptionId: string): void => {
+    resyncSubscriptionManager.unsubscribe(subscriptionId);
+  },
+
+  loadSnapshot: (symbol: string, snapshotJson: string): void => {
+    validateInitialized('loadSnapshot');
+    TpSdkHybridObject.loadOrderBookSnapshot(symbol, snapshotJson);
+  },
+
+  /**
+   * Group symbol's rows by a tick size ("0.1"), or '' for raw levels
+   */
+  setAggregation: (symbol: string, aggregation: string): void => {
+    validateInitialized('setAggregation');
+    TpSdkHybridObject.setOrderBookAggregation(symbol, aggregation);
+  },
+
+  setAggregationLevels: (symbol: string, aggregations: string[]): void => {
+    validateInitialized('setAggregationLevels');
+    TpSdkHybridObject.setOrderBookAggregationLevels(symbol, aggregations);
+  },
 };
 
-export type { OrderBookMessageData };
+export type { OrderBookDiffMessageData, OrderBookMessageData };
@@ -7,6 +7,13 @@
 import { TpSdkHybridObject } from './TpSdkInstance';
 
 let callbackQueueRafId: number | null = null;
+let pushDeliveryEnabled = false;
+
+/**
+ * Time budget (microseconds) for draining callbacks in one frame.
+ * A quarter of a 60 Hz frame leaves room for rendering.
+ */
+export const CALLBACK_FRAME_BUDGET_US = 4000;
 
 /**
  * Process callback queue
@@ -16,36 +23,89 @@ let callbackQueueRafId: number | null = null;
  */
 export function processCallbacks(delayMs?: number): void {
   if (delayMs === undefined || delayMs === 0) {
-    TpSdkHybridObject.processCallbackQueue();
+    const remaining = TpSdkHybridObject.processCallbackQueue(
+      CALLBACK_FRAME_BUDGET_US
+    );
+    if (remaining > 0) {
+      processCallbacksThrottled();
+    }
   } else {
     // Use requestAnimationFrame for better FPS synchronization
-    requestAnimationFrame(() => {
-      TpSdkHybridObject.processCallbackQueue();
-    });
+    processCallbacksThrottled();
   }
 }
 
 /**
  * Process callback queue with RAF throttling
- * Ensures only one RAF callback is scheduled at a time
+ * Ensures only one RAF callback is scheduled at a time.
+ * Each frame drains for up to CALLBACK_FRAME_BUDGET_US and schedules
+ * another frame while callbacks remain queued.
  *
  * @returns void
  */
 export function processCallbacksThrottled(): void {
   if (!callbackQueueRafId) {
     callbackQueueRafId = requestAnimationFrame(() => {
+      let remaining = 0;
       try {
-        console.log('[callbackQueue] Processing callback queue');
-        TpSdkHybridObject.processCallbackQueue();
+        remaining = TpSdkHybridObject.processCallbackQueue(
+          CALLBACK_FRAME_BUDGET_US
+        );
       } catch (err) {
         console.error('[TpSdk] Error processing callback queue:', err);
       } finally {
         callbackQueueRafId = null;
       }
+      if (remaining > 0) {
+        processCallbacksThrottled();
+      }
     });
   }
 }
 
+/**
+ * Enable push-mode delivery
+ *
+ * C++ notifies JS once per coalesced batch of queued callbacks (scheduled on the
+ * JS thread by Nitro), so updates are delivered without waiting for the next frame.
+ * RAF polling is skipped while push mode is enabled.
+ */
+export function enablePushDelivery(): void {
+  TpSdkHybridObject.enablePushDelivery(() => {
+    let remaining = 0;
+    try {
+      // C++ schedules another notification if the budget runs out with items left
+      remaining = TpSdkHybridObject.processCallbackQueue(
+        CALLBACK_FRAME_BUDGET_US
+      );
+    } catch (err) {
+      console.error('[TpSdk] Error processing callback queue:', err);
+    }
+    // A trade batch still waiting for its flush timeout: poll on the next frame
+    if (remaining > 0) {
+      processCallbacksThrottled();
+    }
+  });
+  pushDeliveryEnabled = true;
+}
+
+/**
+ * Disable push-mode delivery and fall back to RAF polling
+ */
+export function disablePushDelivery(): void {
+  TpSdkHybridObject.disablePushDelivery();
+  pushDeliveryEnabled = false;
+  // Flush anything queued while the last notification was in flight
+  processCallbacksThrottled();
+}
+
+/**
+ * Whether push-mode delivery is enabled
+ */
+export function isPushDeliveryEnabled(): boolean {
+  return pushDeliveryEnabled;
+}
+
 /**
  * Process a fake WebSocket message and trigger callbacks
  *
@@ -60,5 +120,8 @@ export function processFakeMessage(
   TpSdkHybridObject.processWebSocketMessage(fakeMessage);
 
   // Process callback queue using requestAnimationFrame for better FPS
-  processCallbacks(delayMs);
+  // (push mode delivers on its own)
+  if (!pushDeliveryEnabled) {
+    processCallbacks(delayMs);
+  }
 }
@@ -60,7 +60,7 @@ export interface OrderBookMessageData {
 }
 
 export interface OrderBookDataItem {
-  eventType: string;
+  eventType: string; // "depthSnapshot": bids/asks are the best levels of the native merged book (replace, don't merge)
   eventTime: number;
   symbol: string;
   firstUpdateId: string;
@@ -68,6 +68,46 @@ export interface OrderBookDataItem {
   bids: [string, string][];
   asks: [string, string][];
   dsTime: number;
+  bidCumulative: number[]; // Running quantity total per bids row (best first)
+  askCumulative: number[]; // Running quantity total per asks row (best first)
+  bidBarRatios: number[]; // Depth bar width per bids row, 0..1 (shared scale with asks)
+  askBarRatios: number[]; // Depth bar width per asks row, 0..1 (shared scale with bids)
+  bidDepthChart: number[]; // Depth chart of every bids level in the book (not only the rows), downsampled: [price, cumulative, ...]
+  askDepthChart: number[]; // Depth chart of every asks level in the book (not only the rows), downsampled: [price, cumulative, ...]
+  synced: boolean; // false: built from diff deltas without a snapshot (no subscribeResync handler), levels may be stale
+}
+
+export enum OrderBookRowOpType {
+  INSERT = 0,
+  UPDATE = 1,
+  REMOVE = 2,
+}
+
+export interface OrderBookRowOp {
+  type: OrderBookRowOpType;
+  index: number; // Row index when the op is applied, ops in order (best = 0)
+  price: string; // Empty for REMOVE
+  quantity: string; // Empty for REMOVE
+}
+
+// Patch against the previously delivered view of a symbol's book (diff mode)
+export interface OrderBookDiffMessageData {
+  stream: string; // Symbol
+  version: number; // +1 per patch of this symbol; a gap means a patch was missed (request a keyframe)
+  keyframe: boolean; // Ops rebuild the view from empty (first patch, periodic, or requested)
+  synced: boolean; // As in OrderBookDataItem
+  bids: OrderBookRowOp[]; // Only rows whose price/quantity changed
+  asks: OrderBookRowOp[];
+  // Whole arrays as in OrderBookDataItem (one entry per row after the ops); absent = unchanged (always set on keyframes)
+  bidCumulative?: number[];
+  askCumulative?: number[];
+  bidBarRatios?: number[];
+  askBarRatios?: number[];
+  bidDepthChart?: number[];
+  askDepthChart?: number[];
+  eventTime: number;
+  finalUpdateId: string;
+  wsTime: number;
 }
 
 export type TradeSide = 'buy' | 'sell';